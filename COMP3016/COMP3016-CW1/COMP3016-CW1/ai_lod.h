@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// Distance-based level of detail for zombie AI. Far from the player a
+// zombie's heading barely changes from one tick to the next, so it doesn't
+// need a crowd query and a flow lookup every tick:
+//
+//   near   inside nearRadius: full steering (flow + crowd) every
+//          nearInterval ticks (default 1, every tick)
+//   mid    inside midRadius: full steering every midInterval ticks
+//   far    beyond: re-aimed along the flow field (no crowd) every
+//          farInterval ticks
+//
+// Between re-steers a zombie integrates its cached velocity. Re-steers are
+// bucketed by handle slot modulo the interval, so a tier's work spreads
+// evenly over its ticks instead of the whole horde turning at once. With a
+// steerBudget every interval is stretched to at least ceil(n / budget), so
+// the re-steers per tick stay near the budget however big the horde gets;
+// a horde within the budget isn't slowed down at all.
+// enabled = false puts everyone in the near tier. Tunable from
+// data/waves.txt (see load_wave_config).
+struct AiLodConfig {
+    bool  enabled{ true };
+    float nearRadius{ 400.f };
+    float midRadius{ 800.f };
+    int   nearInterval{ 1 };
+    int   midInterval{ 4 };
+    int   farInterval{ 16 };
+    int   steerBudget{ 8192 };      // re-steers per tick to aim for, 0 = no cap
+};
+
+enum AiTier { AI_NEAR, AI_MID, AI_FAR, AI_TIER_COUNT };
+
+inline const char* ai_tier_name(int t) {
+    return t == AI_NEAR ? "near" : t == AI_MID ? "mid" : "far";
+}
+
+// per-tick counts: zombies in each tier, and how many of them re-steered
+struct AiLodStats {
+    int tier[AI_TIER_COUNT]{};
+    int steered[AI_TIER_COUNT]{};
+
+    void add(const AiLodStats& o) {
+        for (int t = 0; t < AI_TIER_COUNT; t++) { tier[t] += o.tier[t]; steered[t] += o.steered[t]; }
+    }
+    int total() const { return tier[AI_NEAR] + tier[AI_MID] + tier[AI_FAR]; }
+    int total_steered() const { return steered[AI_NEAR] + steered[AI_MID] + steered[AI_FAR]; }
+};
+
+// d2: squared distance to the player
+inline AiTier ai_tier(float d2, const AiLodConfig& c) {
+    if (!c.enabled || d2 < c.nearRadius * c.nearRadius) return AI_NEAR;
+    return d2 < c.midRadius * c.midRadius ? AI_MID : AI_FAR;
+}
+
+// shortest interval that keeps a horde of n within the steer budget
+inline int ai_budget_interval(int n, const AiLodConfig& c) {
+    return c.steerBudget > 0 ? std::max(1, (n + c.steerBudget - 1) / c.steerBudget) : 1;
+}
+
+// whether a zombie of tier t with handle slot `slot` re-steers on `tick`;
+// minInterval from ai_budget_interval()
+inline bool ai_due(AiTier t, uint32_t slot, uint64_t tick, const AiLodConfig& c, int minInterval = 1) {
+    const int tierInterval = t == AI_NEAR ? c.nearInterval : t == AI_MID ? c.midInterval : c.farInterval;
+    const uint32_t every = (uint32_t)std::max({ 1, minInterval, tierInterval });
+    return every == 1 || (tick + slot) % every == 0;
+}
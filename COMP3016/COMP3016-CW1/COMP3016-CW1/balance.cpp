@@ -0,0 +1,262 @@
+﻿#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bot.h"
+#include "job_system.h"
+#include "simulation.h"
+#include "wave_config.h"
+
+// Wave-balance runner: plays many seeded games with the bot (bot.h) for
+// every point of a grid over the waves.txt keys, all games of all points
+// side by side on the job system (one single-threaded Simulation per game),
+// and prints one CSV row per grid point: survival wave distribution, kill
+// rate and time to death. Every point plays the same seeds, so differences
+// between points come from the config rather than from luck. Run from the
+// project directory so data/ is found.
+//
+// --games N            games per grid point (default 200)
+// --seed N             seed of the first game, then N+1, ... (default 1)
+// --minutes M          game time cap per game (default 10)
+// --threads N          worker threads, 0 = one per hardware thread
+// --set key=value      override a waves.txt key for every point
+// --sweep key=a,b,...  one grid axis; each item a value or lo:hi:step
+// --games-csv PATH     also write one row per game
+// --bot-aim-error DEG  bot aim error (default 15)
+// --bot-think N        ticks between bot decisions (default 12, 0.2 s)
+//
+// e.g. balance --games 500 --sweep spawnDecay=0.88:0.96:0.02 --sweep waveCountStep=3,5,7
+
+static const int WIDTH = 960, HEIGHT = 540;
+
+struct Axis {
+    std::string key;
+    std::vector<std::string> values;
+};
+
+struct GameResult {
+    int wave{ 0 };
+    bool died{ false };
+    float seconds{ 0.f };
+    int kills{ 0 };
+    int score{ 0 };
+};
+
+static bool apply_key(WaveConfig& cfg, const std::string& key, const std::string& value) {
+    std::istringstream in(value);
+    return set_wave_key(cfg, key, in) && !in.fail();
+}
+
+// "key=rest"; false without a key or '='
+static bool split_assignment(const char* arg, std::string& key, std::string& rest) {
+    const char* eq = std::strchr(arg, '=');
+    if (!eq || eq == arg) return false;
+    key.assign(arg, eq);
+    rest.assign(eq + 1);
+    return true;
+}
+
+// "a,b,lo:hi:step" -> values, ranges expanded
+static bool parse_values(const std::string& list, std::vector<std::string>& out) {
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        double lo, hi, step;
+        if (std::sscanf(item.c_str(), "%lf:%lf:%lf", &lo, &hi, &step) == 3) {
+            if (step <= 0.0 || hi < lo) return false;
+            const int n = (int)std::floor((hi - lo) / step + 1e-6);
+            for (int k = 0; k <= n; k++) {
+                char buf[32];
+                std::snprintf(buf, sizeof(buf), "%g", lo + step * k);
+                out.push_back(buf);
+            }
+        }
+        else if (!item.empty()) out.push_back(item);
+    }
+    return !out.empty();
+}
+
+static GameResult play(const WaveConfig& cfg, const BotConfig& botCfg, uint32_t seed, float maxSeconds) {
+    DeterminismConfig det;
+    det.enabled = true;
+    det.seed = seed;
+    Simulation sim(WIDTH, HEIGHT, det, 1);
+    sim.set_wave_config(cfg);
+    Bot bot(botCfg, seed);
+    const float dt = sim.fixed_tick();
+    while (!sim.game_over() && sim.survive_time() < maxSeconds)
+        sim.step(dt, bot.think(sim));
+
+    GameResult r;
+    r.wave = sim.wave();
+    r.died = sim.game_over();
+    r.seconds = sim.survive_time();
+    r.kills = sim.kill_count();
+    r.score = sim.score_value();
+    return r;
+}
+
+// nearest-rank percentile of sorted values
+template<typename T>
+static T percentile(const std::vector<T>& sorted, double p) {
+    if (sorted.empty()) return T{};
+    size_t k = (size_t)std::ceil(p * (double)sorted.size());
+    return sorted[std::min(sorted.size() - 1, k > 0 ? k - 1 : 0)];
+}
+
+static void print_summary(int point, const std::vector<std::string>& values, const GameResult* games, int n) {
+    std::vector<int> waves;
+    std::vector<float> deaths;
+    double kills = 0.0, seconds = 0.0, waveSum = 0.0;
+    std::map<int, int> hist;
+    for (int g = 0; g < n; g++) {
+        const GameResult& r = games[g];
+        waves.push_back(r.wave);
+        waveSum += r.wave;
+        hist[r.wave]++;
+        kills += r.kills;
+        seconds += r.seconds;
+        if (r.died) deaths.push_back(r.seconds);
+    }
+    std::sort(waves.begin(), waves.end());
+    std::sort(deaths.begin(), deaths.end());
+    double deathMean = 0.0;
+    for (float s : deaths) deathMean += s;
+
+    std::printf("%d", point);
+    for (const std::string& v : values) std::printf(",%s", v.c_str());
+    std::printf(",%d,%d,%.2f,%d,%d,%d,%d,%.2f", n, (int)deaths.size(), waveSum / n,
+        percentile(waves, 0.1), percentile(waves, 0.5), percentile(waves, 0.9), waves.back(),
+        seconds > 0.0 ? kills / (seconds / 60.0) : 0.0);
+    if (deaths.empty()) std::printf(",,");
+    else std::printf(",%.1f,%.1f", deathMean / deaths.size(), percentile(deaths, 0.5));
+    std::printf(",");
+    for (auto it = hist.begin(); it != hist.end(); ++it)
+        std::printf("%s%d:%d", it == hist.begin() ? "" : " ", it->first, it->second);
+    std::printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    int gamesPerPoint = 200, threads = 0;
+    uint32_t firstSeed = 1;
+    float minutes = 10.f;
+    const char* gamesCsv = nullptr;
+    WaveConfig base = load_wave_config("data/waves.txt");
+    std::vector<Axis> axes;
+    BotConfig bot;
+    bot.aimErrorDeg = 15.f;
+    bot.thinkTicks = 12;
+
+    for (int i = 1; i < argc; i++) {
+        const char* opt = argv[i];
+        if (i + 1 == argc) {
+            std::fprintf(stderr, "missing value for %s\n", opt);
+            return 2;
+        }
+        const char* arg = argv[++i];
+        std::string key, rest;
+        if (!std::strcmp(opt, "--games")) gamesPerPoint = std::max(1, std::atoi(arg));
+        else if (!std::strcmp(opt, "--seed")) firstSeed = (uint32_t)std::strtoul(arg, nullptr, 10);
+        else if (!std::strcmp(opt, "--minutes")) minutes = std::max(0.1f, (float)std::atof(arg));
+        else if (!std::strcmp(opt, "--threads")) threads = std::max(0, std::atoi(arg));
+        else if (!std::strcmp(opt, "--games-csv")) gamesCsv = arg;
+        else if (!std::strcmp(opt, "--bot-aim-error")) bot.aimErrorDeg = std::max(0.f, (float)std::atof(arg));
+        else if (!std::strcmp(opt, "--bot-think")) bot.thinkTicks = std::max(1, std::atoi(arg));
+        else if (!std::strcmp(opt, "--set")) {
+            if (!split_assignment(arg, key, rest) || !apply_key(base, key, rest)) {
+                std::fprintf(stderr, "bad --set %s\n", arg);
+                return 2;
+            }
+        }
+        else if (!std::strcmp(opt, "--sweep")) {
+            Axis a;
+            WaveConfig probe;
+            if (!split_assignment(arg, a.key, rest) || !parse_values(rest, a.values) || !apply_key(probe, a.key, a.values[0])) {
+                std::fprintf(stderr, "bad --sweep %s\n", arg);
+                return 2;
+            }
+            axes.push_back(a);
+        }
+        else {
+            std::fprintf(stderr, "unknown option %s\n", opt);
+            return 2;
+        }
+    }
+
+    // the grid, first axis varying slowest
+    std::vector<std::vector<std::string>> points(1);
+    for (const Axis& a : axes) {
+        std::vector<std::vector<std::string>> next;
+        for (const auto& p : points)
+            for (const std::string& v : a.values) {
+                next.push_back(p);
+                next.back().push_back(v);
+            }
+        points.swap(next);
+    }
+    std::vector<WaveConfig> configs;
+    for (const auto& p : points) {
+        WaveConfig c = base;
+        for (size_t k = 0; k < axes.size(); k++) {
+            if (!apply_key(c, axes[k].key, p[k])) {
+                std::fprintf(stderr, "bad value %s for %s\n", p[k].c_str(), axes[k].key.c_str());
+                return 2;
+            }
+        }
+        sanitize_wave_config(c);
+        configs.push_back(c);
+    }
+
+    const int total = (int)configs.size() * gamesPerPoint;
+    const float maxSeconds = minutes * 60.f;
+    std::vector<GameResult> results(total);
+    std::atomic<int> done{ 0 };
+    const int progressEvery = std::max(1, total / 20);
+
+    JobSystem jobs(threads, enter_deterministic_fp);
+    std::fprintf(stderr, "%zu points x %d games, %.1f min cap, %d threads\n",
+        configs.size(), gamesPerPoint, minutes, jobs.thread_count());
+    auto t0 = std::chrono::steady_clock::now();
+    jobs.parallel_for(total, 1, [&](int b, int e) {
+        for (int k = b; k < e; k++) {
+            results[k] = play(configs[k / gamesPerPoint], bot, firstSeed + (uint32_t)(k % gamesPerPoint), maxSeconds);
+            int n = done.fetch_add(1) + 1;
+            if (n % progressEvery == 0) std::fprintf(stderr, "  %d/%d games\n", n, total);
+        }
+    });
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double gameSeconds = 0.0;
+    for (const GameResult& r : results) gameSeconds += r.seconds;
+    std::fprintf(stderr, "%d games in %.1f s, %.0f games/s, %.0fx real time\n",
+        total, sec, sec > 0.0 ? total / sec : 0.0, sec > 0.0 ? gameSeconds / sec : 0.0);
+
+    std::printf("point");
+    for (const Axis& a : axes) std::printf(",%s", a.key.c_str());
+    std::printf(",games,deaths,wave_mean,wave_p10,wave_p50,wave_p90,wave_max,kills_per_min,death_s_mean,death_s_p50,wave_hist\n");
+    for (size_t p = 0; p < configs.size(); p++)
+        print_summary((int)p, points[p], &results[p * gamesPerPoint], gamesPerPoint);
+
+    if (gamesCsv) {
+        std::FILE* f = std::fopen(gamesCsv, "w");
+        if (!f) {
+            std::fprintf(stderr, "can't write %s\n", gamesCsv);
+            return 1;
+        }
+        std::fprintf(f, "point,seed,wave,died,seconds,kills,score\n");
+        for (int k = 0; k < total; k++) {
+            const GameResult& r = results[k];
+            std::fprintf(f, "%d,%u,%d,%d,%.2f,%d,%d\n", k / gamesPerPoint, firstSeed + (uint32_t)(k % gamesPerPoint),
+                r.wave, r.died ? 1 : 0, r.seconds, r.kills, r.score);
+        }
+        std::fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include "input.h"
+#include "simulation.h"
+#include "vec2.h"
+
+// Scripted player for tools: reads the simulation and returns the SimInput
+// a player would give it this tick. Kites (backs away from zombies inside
+// kiteRadius while circling the closest one, and keeps off walls and
+// obstacles), aims at the nearest zombie with lead and fires whenever it's
+// in range of the current weapon. Takes the shotgun into a crowd and the
+// rifle against a big horde while they have ammo, the pistol otherwise;
+// it only goes through SimInput, like a player would. It looks again only every thinkTicks
+// ticks (holding its keys in between, like a reaction time) and misses by
+// up to aimErrorDeg, from its own seeded rng, so a seeded run stays
+// deterministic.
+struct BotConfig {
+    float kiteRadius{ 160.f };      // zombies inside this push the bot away
+    float circleWeight{ 0.6f };     // sideways step around the closest zombie
+    float wallMargin{ 70.f };       // arena edges and obstacles push back inside this
+    float lead{ 1.f };              // aim ahead by velocity * time of flight, 0 = at it
+    float aimErrorDeg{ 0.f };       // uniform aim error, either way
+    int   thinkTicks{ 1 };          // ticks between decisions
+    bool  switchWeapons{ true };
+    int   shotgunCrowd{ 4 };        // zombies inside shotgunRange to take the shotgun
+    float shotgunRange{ 110.f };
+    int   rifleHorde{ 10 };         // zombies alive to take the rifle
+};
+
+class Bot {
+public:
+    explicit Bot(const BotConfig& c = {}, uint32_t seed = 1) : cfg(c), rng(seed) {}
+
+    // the input for this tick; call once per step()
+    SimInput think(const Simulation& sim) {
+        if (wait > 0) {
+            wait--;
+            return held;
+        }
+        wait = std::max(1, cfg.thinkTicks) - 1;
+        held = decide(sim);
+        return held;
+    }
+
+    const BotConfig& config() const { return cfg; }
+
+private:
+    BotConfig cfg;
+    std::mt19937 rng;
+    SimInput held;
+    int wait{ 0 };
+
+    SimInput decide(const Simulation& sim) {
+        SimInput in;
+        const Vec2 p = sim.player_position();
+        const ZombieArch& zs = sim.zombie_rows();
+        const Transform* tf = zs.data<Transform>();
+        const Velocity* vel = zs.data<Velocity>();
+
+        // nearest zombie, and the push away from everything close
+        int nearest = -1;
+        float nearestD2 = 0.f;
+        Vec2 push{};
+        int close = 0;
+        const float sr2 = cfg.shotgunRange * cfg.shotgunRange;
+        const float kr2 = cfg.kiteRadius * cfg.kiteRadius;
+        for (int i = 0; i < zs.size(); i++) {
+            Vec2 d = p - tf[i].pos;
+            float d2 = d.x * d.x + d.y * d.y;
+            if (nearest < 0 || d2 < nearestD2) { nearest = i; nearestD2 = d2; }
+            close += d2 < sr2;
+            if (d2 < kr2 && d2 > 0.0001f) {
+                float dist = std::sqrt(d2);
+                push += d * ((1.f - dist / cfg.kiteRadius) / dist);
+            }
+        }
+        if (nearest >= 0 && nearestD2 < kr2) {
+            Vec2 away = (p - tf[nearest].pos).normalized();
+            push += Vec2{ -away.y, away.x } * cfg.circleWeight;
+        }
+        push += wall_push(sim, p);
+
+        // nothing close: drift back toward the middle, where there's room
+        const Vec2 centre{ sim.arena_width() * 0.5f, sim.arena_height() * 0.5f };
+        if (push.len() < 0.05f && (centre - p).len() > 120.f) push = (centre - p).normalized() * 0.5f;
+
+        // eight-way keys, like a person on WASD
+        Vec2 dir = push.normalized();
+        in.right = dir.x > 0.38f;
+        in.left = dir.x < -0.38f;
+        in.down = dir.y > 0.38f;
+        in.up = dir.y < -0.38f;
+
+        const Player& pl = sim.player_state();
+        if (cfg.switchWeapons) {
+            int want = pick_weapon(pl, close, zs.size());
+            if (want != pl.weapon_index()) in.weapon = want;
+        }
+        // range and bullet speed of the weapon this tick fires with
+        const Weapon& w = in.weapon >= 0 ? pl.weapon(in.weapon) : pl.current();
+        if (nearest < 0) {
+            in.aim = p + pl.aim() * 100.f;
+            return in;
+        }
+        const float dist = std::sqrt(nearestD2);
+        Vec2 target = tf[nearest].pos + vel[nearest].vel * (cfg.lead * dist / w.bulletSpeed);
+        if (cfg.aimErrorDeg > 0.f) {
+            float e = std::uniform_real_distribution<float>(-cfg.aimErrorDeg, cfg.aimErrorDeg)(rng) * (PI / 180.f);
+            Vec2 d = target - p;
+            float c = std::cos(e), s = std::sin(e);
+            target = p + Vec2{ d.x * c - d.y * s, d.x * s + d.y * c };
+        }
+        in.aim = target;
+        in.shoot = dist < w.bulletSpeed * w.bulletLife;
+        return in;
+    }
+
+    int pick_weapon(const Player& pl, int close, int alive) const {
+        if (close >= cfg.shotgunCrowd && pl.shotgunAmmo != 0) return 1;
+        if (alive >= cfg.rifleHorde && pl.rifleAmmo != 0) return 2;
+        return 0;
+    }
+
+    Vec2 wall_push(const Simulation& sim, const Vec2& p) const {
+        const float m = cfg.wallMargin;
+        const float minX = 20.f, minY = 20.f;
+        const float maxX = sim.arena_width() - 20.f, maxY = sim.arena_height() - 20.f;
+        Vec2 push{};
+        if (p.x - minX < m) push.x += 1.f - (p.x - minX) / m;
+        if (maxX - p.x < m) push.x -= 1.f - (maxX - p.x) / m;
+        if (p.y - minY < m) push.y += 1.f - (p.y - minY) / m;
+        if (maxY - p.y < m) push.y -= 1.f - (maxY - p.y) / m;
+
+        // obstacles: away from the closest point of each rect within half the margin
+        const float om = m * 0.5f;
+        for (const Obstacle& o : sim.obstacle_list()) {
+            Vec2 q{ std::clamp(p.x, o.x, o.x + o.w), std::clamp(p.y, o.y, o.y + o.h) };
+            Vec2 d = p - q;
+            float dist = d.len();
+            if (dist > 0.0001f && dist < om) push += d * ((1.f - dist / om) / dist);
+        }
+        return push;
+    }
+};
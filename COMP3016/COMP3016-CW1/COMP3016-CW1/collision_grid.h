@@ -0,0 +1,154 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vec2.h"
+
+// Static map geometry (walls and crates) rasterized into a fine boolean grid.
+// Circles are resolved as their bounding box against the blocked cells, one
+// axis at a time, so every query touches a fixed number of cells.
+// Bullets walk their segment cell by cell (DDA) and can't skip a cell.
+
+struct Obstacle {
+    enum Kind { Wall, Crate };
+    Kind kind{ Wall };
+    float x{}, y{}, w{}, h{};
+};
+
+// data/obstacles.txt, one per line:  wall|crate  x y w h
+inline std::vector<Obstacle> load_obstacles(const std::string& path) {
+    std::vector<Obstacle> out;
+    std::ifstream f(path);
+    if (!f.good()) return out;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string kind;
+        Obstacle o{};
+        if (!(iss >> kind >> o.x >> o.y >> o.w >> o.h)) continue;
+        if (kind == "wall")       o.kind = Obstacle::Wall;
+        else if (kind == "crate") o.kind = Obstacle::Crate;
+        else continue;
+        if (o.w > 0.f && o.h > 0.f) out.push_back(o);
+    }
+    return out;
+}
+
+class CollisionGrid {
+public:
+    void reset(float worldW, float worldH, float cell) {
+        cellSize = cell;
+        invCell = 1.f / cell;
+        cols = std::max(1, (int)std::ceil(worldW * invCell));
+        rows = std::max(1, (int)std::ceil(worldH * invCell));
+        blocked.assign((size_t)cols * rows, 0);
+        any = false;
+    }
+
+    void add_rect(float x, float y, float w, float h) {
+        int x0 = std::max(0, (int)std::floor(x * invCell)), x1 = std::min(cols - 1, (int)std::ceil((x + w) * invCell) - 1);
+        int y0 = std::max(0, (int)std::floor(y * invCell)), y1 = std::min(rows - 1, (int)std::ceil((y + h) * invCell) - 1);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++) blocked[(size_t)cy * cols + cx] = 1;
+        if (x0 <= x1 && y0 <= y1) any = true;
+    }
+
+    bool empty() const { return !any; }
+    float cell_size() const { return cellSize; }
+
+    bool blocked_at(float x, float y) const {
+        int cx = (int)std::floor(x * invCell), cy = (int)std::floor(y * invCell);
+        return cell_blocked(cx, cy);
+    }
+
+    // any blocked cell under the box [x0,x1] x [y0,y1]
+    bool box_blocked(float x0, float y0, float x1, float y1) const {
+        int cx0 = (int)std::floor(x0 * invCell), cx1 = (int)std::floor(x1 * invCell);
+        int cy0 = (int)std::floor(y0 * invCell), cy1 = (int)std::floor(y1 * invCell);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++)
+                if (cell_blocked(cx, cy)) return true;
+        return false;
+    }
+
+    bool overlaps(const Vec2& p, float r) const {
+        return box_blocked(p.x - r, p.y - r, p.x + r, p.y + r);
+    }
+
+    // move a circle by delta, stopping flush against blocked cells and
+    // sliding along them. A circle that starts inside geometry (spawned or
+    // shoved there) is let through so it can work its way out.
+    Vec2 move_circle(const Vec2& p, const Vec2& delta, float r) const {
+        if (!any || overlaps(p, r)) return p + delta;
+        Vec2 q = p;
+        q.x = sweep_axis(q.x, delta.x, q.y, r, true);
+        q.y = sweep_axis(q.y, delta.y, q.x, r, false);
+        return q;
+    }
+
+    // first blocked point on the segment a -> b, if any
+    bool segment_hit(const Vec2& a, const Vec2& b, Vec2* hit = nullptr) const {
+        if (!any) return false;
+        int cx = (int)std::floor(a.x * invCell), cy = (int)std::floor(a.y * invCell);
+        const int ex = (int)std::floor(b.x * invCell), ey = (int)std::floor(b.y * invCell);
+        Vec2 d = b - a;
+        int sx = d.x > 0 ? 1 : -1, sy = d.y > 0 ? 1 : -1;
+        float tdx = d.x != 0.f ? std::abs(cellSize / d.x) : INFINITY;
+        float tdy = d.y != 0.f ? std::abs(cellSize / d.y) : INFINITY;
+        float nx = (sx > 0 ? (cx + 1) * cellSize : cx * cellSize);
+        float ny = (sy > 0 ? (cy + 1) * cellSize : cy * cellSize);
+        float tx = d.x != 0.f ? (nx - a.x) / d.x : INFINITY;
+        float ty = d.y != 0.f ? (ny - a.y) / d.y : INFINITY;
+        float t = 0.f;
+        for (;;) {
+            if (cell_blocked(cx, cy)) {
+                if (hit) *hit = a + d * t;
+                return true;
+            }
+            if (cx == ex && cy == ey) return false;
+            if (tx < ty) { t = tx; tx += tdx; cx += sx; }
+            else         { t = ty; ty += tdy; cy += sy; }
+            if (t > 1.f) return false;
+        }
+    }
+
+private:
+    float cellSize{ 1.f }, invCell{ 1.f };
+    int cols{ 1 }, rows{ 1 };
+    std::vector<uint8_t> blocked;
+    bool any{ false };
+
+    bool cell_blocked(int cx, int cy) const {
+        if (cx < 0 || cy < 0 || cx >= cols || cy >= rows) return false;
+        return blocked[(size_t)cy * cols + cx] != 0;
+    }
+
+    // one axis of move_circle: scan the cell columns (or rows) the leading
+    // edge passes and stop at the first blocked one
+    float sweep_axis(float c, float d, float other, float r, bool xAxis) const {
+        if (d == 0.f) return c;
+        float lo = other - r, hi = other + r;
+        int o0 = (int)std::floor(lo * invCell), o1 = (int)std::floor(hi * invCell);
+        float edge = d > 0 ? c + r : c - r;
+        int from = (int)std::floor(edge * invCell), to = (int)std::floor((edge + d) * invCell);
+        int step = d > 0 ? 1 : -1;
+        for (int k = from; ; k += step) {
+            for (int o = o0; o <= o1; o++) {
+                bool b = xAxis ? cell_blocked(k, o) : cell_blocked(o, k);
+                if (b) {
+                    const float eps = 0.01f;
+                    return d > 0 ? k * cellSize - r - eps : (k + 1) * cellSize + r + eps;
+                }
+            }
+            if (k == to) break;
+        }
+        return c + d;
+    }
+};
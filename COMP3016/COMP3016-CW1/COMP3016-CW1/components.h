@@ -0,0 +1,37 @@
+﻿#pragma once
+
+#include "ecs.h"
+#include "vec2.h"
+
+// Game components and archetypes (ecs.h).
+// Transform, Velocity, Sprite and AI wrap a single Vec2/float so their
+// columns can be handed to the steering kernel as plain arrays
+// (zombie_kernels.h).
+
+struct Transform { Vec2 pos; };
+struct Velocity  { Vec2 vel; };
+struct Collider  { float radius{ 12.f }; };
+struct Sprite    { Vec2 faceDir{ 1,0 }; };          // picks one of 8 facing sprites
+struct Lifetime  { float age{ 0.f }, life{ 1.2f }; };
+struct Health    { int hp{ 1 }; };
+struct AI        { float speed{ 90.f }; };
+struct Sweep     { Vec2 from; };                    // position at the start of the tick
+
+static_assert(sizeof(Transform) == sizeof(Vec2) && sizeof(Velocity) == sizeof(Vec2) &&
+    sizeof(Sprite) == sizeof(Vec2) && sizeof(AI) == sizeof(float), "kernel columns must stay packed");
+
+using PlayerArch = Archetype<Transform, Velocity, Collider, Sprite, Health>;
+using ZombieArch = Archetype<Transform, Velocity, Collider, Sprite, Health, AI, Sweep>;
+using BulletArch = Archetype<Transform, Velocity, Collider, Lifetime, Sweep>;
+
+using GameWorld = World<PlayerArch, ZombieArch, BulletArch>;
+
+// -1 when the zombie archetype is full or out of handle slots
+inline int spawn_zombie_at(ZombieArch& zs, const Vec2& p, float speed, float radius = 14.f) {
+    return zs.add(Transform{ p }, Velocity{}, Collider{ radius }, Sprite{}, Health{ 1 }, AI{ speed }, Sweep{ p });
+}
+
+// -1 when the bullet archetype is at its fixed capacity
+inline int spawn_bullet(BulletArch& bs, const Vec2& p, const Vec2& v, float life = 1.2f, float radius = 4.f) {
+    return bs.add(Transform{ p }, Velocity{ v }, Collider{ radius }, Lifetime{ 0.f, life }, Sweep{ p });
+}
@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "job_system.h"
+#include "render_stats.h"
+#include "vec2.h"
+
+inline SDL_Texture* load_any(SDL_Renderer* r,
+    const char* p1,
+    const char* p2 = nullptr,
+    const char* p3 = nullptr)
+{
+    SDL_Texture* t = nullptr;
+    if (!t && p1) t = IMG_LoadTexture(r, p1);
+    if (!t && p2) t = IMG_LoadTexture(r, p2);
+    if (!t && p3) t = IMG_LoadTexture(r, p3);
+    if (t) SDL_SetTextureScaleMode(t, SDL_SCALEMODE_NEAREST); 
+    return note_texture_created(t);
+}
+
+// load_any for many textures at once: files are decoded to surfaces on the
+// job system's workers, textures are created on the main thread (renderer
+// calls are not thread-safe). Targets stay null if no path loads.
+class TextureBatch {
+public:
+    void add(SDL_Texture** out, const char* p1, const char* p2 = nullptr, const char* p3 = nullptr) {
+        items.push_back(Item{ out, { p1, p2, p3 } });
+    }
+
+    // blocks; call on the job system's main thread
+    void load(SDL_Renderer* r, JobSystem& jobs) {
+        TaskGraph g;
+        for (Item& it : items) {
+            int decode = g.add([&it] {
+                for (const char* p : it.paths) if (!it.surface && p) it.surface = IMG_Load(p);
+            });
+            int upload = g.add([&it, r] {
+                if (!it.surface) return;
+                *it.out = note_texture_created(SDL_CreateTextureFromSurface(r, it.surface));
+                if (*it.out) SDL_SetTextureScaleMode(*it.out, SDL_SCALEMODE_NEAREST);
+                SDL_DestroySurface(it.surface);
+                it.surface = nullptr;
+            }, true);
+            g.precede(decode, upload);
+        }
+        jobs.run(g);
+        items.clear();
+    }
+
+private:
+    struct Item {
+        SDL_Texture** out;
+        const char* paths[3];
+        SDL_Surface* surface{};
+    };
+    std::vector<Item> items;
+};
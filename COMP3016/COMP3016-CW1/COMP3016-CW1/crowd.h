@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include <algorithm>
+
+#include "spatial_grid.h"
+#include "vec2.h"
+
+// Boids-style crowd steering so hordes spread out instead of stacking on the
+// same pixel. Tunable from data/waves.txt (see load_wave_config).
+struct CrowdConfig {
+    float radius{ 32.f };           // neighbour radius, also the grid cell size
+    float separationWeight{ 1.4f };
+    float cohesionWeight{ 0.2f };
+    int   maxNeighbours{ 12 };      // the query stops here, bounding dense packs
+};
+
+// Separation + cohesion for agent `self` at p, from neighbours found in a grid
+// built over the same agents. One 3x3 cell lookup per agent that stops
+// after maxNeighbours, so an agent costs at most maxNeighbours accepted
+// neighbours plus the candidates rejected before them (outside the radius),
+// however dense the clump.
+template<typename PosFn>
+Vec2 crowd_force(int self, const Vec2& p, const SpatialGrid& grid, PosFn pos, const CrowdConfig& c) {
+    if (c.maxNeighbours <= 0) return Vec2{ 0,0 };
+    const float r2 = c.radius * c.radius;
+    Vec2 push{ 0,0 }, centre{ 0,0 };
+    int n = 0;
+    grid.query_radius(p, c.radius, [&](int i) {
+        if (i == self) return true;
+        Vec2 q = pos(i);
+        Vec2 d = p - q;
+        float d2 = d.x * d.x + d.y * d.y;
+        if (d2 >= r2) return true;
+        float dist = std::sqrt(d2);
+        // stacked exactly on top of each other: split them by index
+        Vec2 away = (dist > 0.0001f) ? d * (1.f / dist) : Vec2{ self < i ? -1.f : 1.f, 0.f };
+        push += away * (1.f - dist / c.radius);
+        centre += q;
+        return ++n < c.maxNeighbours;
+    });
+    if (n == 0) return Vec2{ 0,0 };
+
+    Vec2 toCentre = (centre * (1.f / n) - p) * (1.f / c.radius);
+    return push * c.separationWeight + toCentre * c.cohesionWeight;
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+
+#include <cfenv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <xmmintrin.h>
+#include <pmmintrin.h>
+#define DET_X86 1
+#else
+#define DET_X86 0
+#endif
+
+// Deterministic simulation: an explicit seed, a fixed tick and a pinned
+// floating-point environment, so two runs fed the same input produce the
+// same state bit for bit (same binary; <random> distributions and libm are
+// not portable between standard libraries). Game hashes its state after
+// every tick (StateHash) and can log the hashes, so a replay, a lockstep
+// peer or a regression run can be diffed to find the first tick that
+// diverged.
+struct DeterminismConfig {
+    bool enabled{ false };
+    uint32_t seed{ 1 };
+    float tick{ 1.f / 60.f };       // fixed dt passed to Game::update
+    std::string hashLog;            // "tick hash" per line; empty = off
+};
+
+// Round to nearest, denormals kept (no FTZ/DAZ). These are the defaults, but
+// a library or driver can change them behind our back. The mode is per
+// thread: call it on every thread that runs simulation code.
+inline void enter_deterministic_fp() {
+    std::fesetround(FE_TONEAREST);
+#if DET_X86
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_OFF);
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_OFF);
+#endif
+}
+
+// 64-bit hash over raw state, 8 bytes per step in four independent lanes so
+// the multiplies overlap (~1 ms for 100k zombies). Not cryptographic, it
+// only has to change when any bit of the state does.
+class StateHash {
+public:
+    void add_bytes(const void* data, size_t n) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (; n >= 32; p += 32, n -= 32) {
+            uint64_t w[4];
+            std::memcpy(w, p, 32);
+            for (int k = 0; k < 4; k++) lane[k] = mix(lane[k] ^ w[k]);
+        }
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t w;
+            std::memcpy(&w, p, 8);
+            lane[0] = mix(lane[0] ^ w);
+        }
+        if (n) {
+            uint64_t w = 0;
+            std::memcpy(&w, p, n);
+            lane[1] = mix(lane[1] ^ w ^ (uint64_t(n) << 56));
+        }
+    }
+
+    template<typename T>
+    void add(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "hash raw state only");
+        add_bytes(&v, sizeof(T));
+    }
+
+    template<typename T>
+    void add_array(const T* v, int n) {
+        static_assert(std::is_trivially_copyable_v<T>, "hash raw state only");
+        add(n);
+        add_bytes(v, sizeof(T) * (size_t)n);
+    }
+
+    uint64_t value() const {
+        uint64_t h = lane[0];
+        for (int k = 1; k < 4; k++) h = mix(h ^ (lane[k] + 0x9E3779B97F4A7C15ull * k));
+        return h;
+    }
+
+private:
+    uint64_t lane[4]{ 0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull };
+
+    static uint64_t mix(uint64_t x) {
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 31;
+        return x;
+    }
+};
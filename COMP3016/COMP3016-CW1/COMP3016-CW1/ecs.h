@@ -0,0 +1,263 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "job_system.h"
+#include "slot_map.h"
+
+// Minimal archetype entity-component system.
+// An archetype is a fixed list of component types; each entity is a row and
+// each component is one contiguous column, so a system streams only the
+// columns it asks for. The archetypes are fixed at compile time (World<...>)
+// and a query visits every archetype that has all the requested components.
+// Rows carry an alive flag: systems only mark, remove_dead() compacts between
+// ticks (no structural changes while systems run), keeping row order unless
+// the archetype opted into swap-and-pop removal. Archetypes can also hand
+// out generational handles (slot_map.h) that survive those moves.
+
+// tag for access sets: the alive column of an archetype
+struct Alive {};
+
+template<typename... Cs>
+class Archetype {
+public:
+    static_assert(sizeof...(Cs) < 8, "7 components max, slot 7 is the alive column");
+
+    template<typename C>
+    static constexpr bool has = (std::is_same_v<C, Cs> || ...);
+
+    // column slot of C, used for access bits
+    template<typename C>
+    static constexpr int slot() {
+        if constexpr (std::is_same_v<C, Alive>) return 7;
+        else {
+            static_assert(has<C>, "component not in archetype");
+            int i = 0, found = 0;
+            ((std::is_same_v<C, Cs> ? (found = i, i++) : i++), ...);
+            return found;
+        }
+    }
+
+    std::vector<uint8_t> alive;
+
+    int size() const { return (int)alive.size(); }
+    bool empty() const { return alive.empty(); }
+
+    // -1 when a fixed capacity is set and full, or handles are on and the
+    // slot map is out of slots
+    int add(const Cs&... cs) {
+        if (fixedCapacity > 0 && size() >= fixedCapacity) return -1;
+        if (useHandles && !slots.insert()) return -1;
+        (column<Cs>().push_back(cs), ...);
+        alive.push_back(1);
+        return size() - 1;
+    }
+
+    template<typename C> C& get(int i) { return column<C>()[i]; }
+    template<typename C> const C& get(int i) const { return column<C>()[i]; }
+    template<typename C> C* data() { return column<C>().data(); }
+    template<typename C> const C* data() const { return column<C>().data(); }
+
+    // fn(const C*, n) once per component column, in declaration order
+    template<typename Fn>
+    void visit_columns(Fn&& fn) const { (fn(data<Cs>(), size()), ...); }
+
+    void clear() { (column<Cs>().clear(), ...); alive.clear(); slots.clear(); }
+    void reserve(int n) { (column<Cs>().reserve(n), ...); alive.reserve(n); if (useHandles) slots.reserve(n); }
+
+    // Preallocate n rows and never grow past them: add() and remove_dead()
+    // then never touch the allocator.
+    void set_capacity(int n) { fixedCapacity = n; reserve(n); }
+    int capacity() const { return fixedCapacity; }
+
+    // Dead rows are filled from the back instead of shifting everything
+    // down: only the dead cost anything, but row order is not kept.
+    void set_swap_remove(bool on) { swapRemove = on; }
+
+    // Stable handles for rows; enable before adding anything.
+    void set_handles(bool on) { useHandles = on; if (on) slots.reserve((int)alive.capacity()); }
+    Handle handle(int row) const { return slots.handle(row); }
+    int row_of(Handle h) const { return useHandles ? slots.row(h) : -1; }
+
+    void remove_dead() {
+        if (swapRemove) {
+            int n = size();
+            for (int i = 0; i < n;) {
+                if (alive[i]) { i++; continue; }
+                if (useHandles) slots.release(i);
+                n--;
+                if (i != n) {
+                    ((column<Cs>()[i] = column<Cs>()[n]), ...);
+                    alive[i] = alive[n];
+                    if (useHandles) slots.moved(n, i);
+                }
+            }
+            truncate(n);
+            return;
+        }
+        int w = 0;
+        for (int i = 0; i < size(); i++) {
+            if (!alive[i]) { if (useHandles) slots.release(i); continue; }
+            if (w != i) {
+                ((column<Cs>()[w] = column<Cs>()[i]), ...);
+                alive[w] = 1;
+                if (useHandles) slots.moved(i, w);
+            }
+            w++;
+        }
+        truncate(w);
+    }
+
+private:
+    std::tuple<std::vector<Cs>...> columns;
+    int fixedCapacity{ 0 };
+    bool swapRemove{ false };
+    bool useHandles{ false };
+    SlotMap slots;
+
+    void truncate(int n) {
+        (column<Cs>().resize(n), ...);
+        alive.resize(n);
+        if (useHandles) slots.truncate(n);
+    }
+
+    template<typename C> std::vector<C>& column() { return std::get<std::vector<C>>(columns); }
+    template<typename C> const std::vector<C>& column() const { return std::get<std::vector<C>>(columns); }
+};
+
+template<typename... As>
+class World {
+public:
+    static_assert(sizeof...(As) <= 6, "access bits hold 6 archetypes");
+
+    template<typename A> A& get() { return std::get<A>(archetypes); }
+    template<typename A> const A& get() const { return std::get<A>(archetypes); }
+
+    // fn(C&...) for every live row of every archetype with all of Cs
+    template<typename... Cs, typename Fn>
+    void each(Fn&& fn) {
+        std::apply([&](auto&... a) { (each_in<Cs...>(a, fn), ...); }, archetypes);
+    }
+
+    // fn(n, C*...) once per archetype with all of Cs, whole columns
+    template<typename... Cs, typename Fn>
+    void each_column(Fn&& fn) {
+        std::apply([&](auto&... a) { (column_in<Cs...>(a, fn), ...); }, archetypes);
+    }
+
+    void remove_dead() { std::apply([](auto&... a) { (a.remove_dead(), ...); }, archetypes); }
+
+    // fn(const A&) once per archetype, in declaration order
+    template<typename Fn>
+    void visit(Fn&& fn) const { std::apply([&](const auto&... a) { (fn(a), ...); }, archetypes); }
+
+    // access bits for columns Cs of archetype A (see Access)
+    template<typename A, typename... Cs>
+    static constexpr uint64_t cols() {
+        return ((uint64_t(1) << (index_of<A>() * 8 + A::template slot<Cs>())) | ...);
+    }
+
+private:
+    std::tuple<As...> archetypes;
+
+    template<typename A>
+    static constexpr int index_of() {
+        int i = 0, found = -1;
+        ((std::is_same_v<A, As> ? (found = i, i++) : i++), ...);
+        return found;
+    }
+
+    template<typename... Cs, typename A, typename Fn>
+    static void each_in(A& a, Fn& fn) {
+        if constexpr ((A::template has<Cs> && ...)) {
+            for (int i = 0; i < a.size(); i++)
+                if (a.alive[i]) fn(a.template get<Cs>(i)...);
+        }
+    }
+
+    template<typename... Cs, typename A, typename Fn>
+    static void column_in(A& a, Fn& fn) {
+        if constexpr ((A::template has<Cs> && ...)) fn(a.size(), a.template data<Cs>()...);
+    }
+};
+
+// What a system touches: World::cols<A, Cs...>() bits for component
+// columns, res(i) bits for shared state outside the world (grids, score).
+// Two systems conflict when one writes something the other reads or writes.
+struct Access {
+    uint64_t reads{ 0 }, writes{ 0 };
+
+    static constexpr uint64_t res(int i) { return uint64_t(1) << (48 + i); }
+
+    bool conflicts(const Access& o) const {
+        return (writes & (o.reads | o.writes)) || (o.writes & reads);
+    }
+};
+
+// Systems run in the order they were added, except that a system only waits
+// for earlier systems it conflicts with. add() places each system in the
+// first stage after all of those; systems sharing a stage can run together.
+class Schedule {
+public:
+    void add(const char* name, const Access& access, std::function<void(float)> fn) {
+        int stage = 0;
+        for (const System& s : systems)
+            if (s.access.conflicts(access)) stage = std::max(stage, s.stage + 1);
+        systems.push_back({ name, access, std::move(fn), stage });
+        if ((int)stages.size() <= stage) stages.resize(stage + 1);
+        stages[stage].push_back((int)systems.size() - 1);
+    }
+
+    // jobs: every extra system in a stage becomes a job, worth it only when
+    // the systems have real work (large hordes); nullptr runs them in order
+    void run(float dt, JobSystem* jobs) {
+        for (const std::vector<int>& stage : stages) {
+            if (!jobs || stage.size() == 1) {
+                for (int s : stage) call(s, dt);
+                continue;
+            }
+            JobCounter c;
+            for (size_t k = 1; k < stage.size(); k++)
+                jobs->spawn([this, dt, s = stage[k]] { call(s, dt); }, c);
+            call(stage[0], dt);
+            jobs->wait(c);
+        }
+    }
+
+    // wall time per system, summed over run() calls while profiling is on;
+    // systems sharing a stage overlap, so the sum can exceed the tick
+    void set_profiling(bool on) { profiling = on; }
+    void reset_timings() { for (System& s : systems) s.ms = 0.0; }
+    double ms_of(int system) const { return systems[system].ms; }
+
+    int stage_count() const { return (int)stages.size(); }
+    int stage_of(int system) const { return systems[system].stage; }
+    const char* name_of(int system) const { return systems[system].name; }
+    int system_count() const { return (int)systems.size(); }
+
+private:
+    struct System {
+        const char* name;
+        Access access;
+        std::function<void(float)> fn;
+        int stage;
+        double ms{ 0.0 };
+    };
+    std::vector<System> systems;
+    std::vector<std::vector<int>> stages;
+    bool profiling{ false };
+
+    void call(int s, float dt) {
+        if (!profiling) { systems[s].fn(dt); return; }
+        auto t0 = std::chrono::steady_clock::now();
+        systems[s].fn(dt);
+        systems[s].ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+};
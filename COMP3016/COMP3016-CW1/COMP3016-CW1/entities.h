@@ -0,0 +1,135 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cmath>
+
+#include "core.h"
+#include "components.h"
+#include "player.h"
+#include "render_stats.h"
+
+// Sprites and drawing of the entities (the SDL side of player.h).
+
+// the eight facing sprites, shared by every zombie
+struct ZombieSprites {
+    SDL_Texture* tex[8]{};
+    float scale{ 0.06f };
+
+    void load(TextureBatch& batch) {
+        const char* pf[8][3] = {
+            {"data/Zombie Right.png",      "data/assets/Zombie Right.png",      "Zombie Right.png"},
+            {"data/Zombie Down Right.png", "data/assets/Zombie Down Right.png", "Zombie Down Right.png"},
+            {"data/Zombie Down.png",       "data/assets/Zombie Down.png",       "Zombie Down.png"},
+            {"data/Zombie Down Left.png",  "data/assets/Zombie Down Left.png",  "Zombie Down Left.png"},
+            {"data/Zombie Left.png",       "data/assets/Zombie Left.png",       "Zombie Left.png"},
+            {"data/Zombie Up Left.png",    "data/assets/Zombie Up Left.png",    "Zombie Up Left.png"},
+            {"data/Zombie Up.png",         "data/assets/Zombie Up.png",         "Zombie Up.png"},
+            {"data/Zombie Up Right.png",   "data/assets/Zombie Up Right.png",   "Zombie Up Right.png"}
+        };
+        for (int i = 0; i < 8; i++) batch.add(&tex[i], pf[i][0], pf[i][1], pf[i][2]);
+    }
+
+    void destroy() {
+        for (auto& t : tex) { destroy_texture(t); t = nullptr; }
+    }
+};
+
+inline void draw_zombies(SDL_Renderer* r, const ZombieArch& zs, const ZombieSprites& sprites) {
+    const Transform* tf = zs.data<Transform>();
+    const Sprite* sp = zs.data<Sprite>();
+    const Collider* col = zs.data<Collider>();
+    for (int i = 0; i < zs.size(); i++) {
+        Vec2 p = tf[i].pos;
+        if (SDL_Texture* t = sprites.tex[facing_sector(sp[i].faceDir)]) {
+            float tw = 0.f, th = 0.f; SDL_GetTextureSize(t, &tw, &th);
+            float s = sprites.scale;
+            SDL_FRect dst{ p.x - (tw * s) / 2.f, p.y - (th * s) / 2.f, tw * s, th * s };
+            render_texture(r, t, nullptr, &dst);
+        }
+        else {
+            float rad = col[i].radius;
+            SDL_FRect rect{ p.x - rad, p.y - rad, rad * 2, rad * 2 };
+            SDL_SetRenderDrawColor(r, 120, 255, 120, 255);
+            render_fill_rect(r, &rect);
+        }
+    }
+}
+
+inline void draw_bullets(SDL_Renderer* r, const BulletArch& bs) {
+    const Transform* tf = bs.data<Transform>();
+    const Collider* col = bs.data<Collider>();
+    SDL_SetRenderDrawColor(r, 255, 230, 110, 255);
+    for (int i = 0; i < bs.size(); i++) {
+        float rad = col[i].radius;
+        SDL_FRect rect{ tf[i].pos.x - rad, tf[i].pos.y - rad, rad * 2, rad * 2 };
+        render_fill_rect(r, &rect);
+    }
+}
+
+// the player's eight facing sprites plus one per weapon
+struct PlayerSprites {
+    SDL_Texture* tex[8]{};
+    SDL_Texture* gun[3]{};
+    float scale{ 0.06f };
+
+    void load(TextureBatch& batch) {
+        const char* pf[8][3] = {
+            {"data/Player Right.png",      "data/assets/Player Right.png",      "Player Right.png"},
+            {"data/Player Down Right.png", "data/assets/Player Down Right.png", "Player Down Right.png"},
+            {"data/Player Down.png",       "data/assets/Player Down.png",       "Player Down.png"},
+            {"data/Player Down Left.png",  "data/assets/Player Down Left.png",  "Player Down Left.png"},
+            {"data/Player Left.png",       "data/assets/Player Left.png",       "Player Left.png"},
+            {"data/Player Up Left.png",    "data/assets/Player Up Left.png",    "Player Up Left.png"},
+            {"data/Player Up.png",         "data/assets/Player Up.png",         "Player Up.png"},
+            {"data/Player Up Right.png",   "data/assets/Player Up Right.png",   "Player Up Right.png"}
+        };
+        for (int i = 0; i < 8; i++) batch.add(&tex[i], pf[i][0], pf[i][1], pf[i][2]);
+
+        batch.add(&gun[0], "data/Pistol.png", "data/assets/Pistol.png", "Pistol.png");
+        batch.add(&gun[1], "data/Shotgun.png", "data/assets/Shotgun.png", "Shotgun.png");
+        batch.add(&gun[2], "data/Rifle.png", "data/assets/Rifle.png", "Rifle.png");
+    }
+
+    void destroy() {
+        for (auto& t : tex) { destroy_texture(t); t = nullptr; }
+        for (auto& t : gun) { destroy_texture(t); t = nullptr; }
+    }
+
+    SDL_Texture* pick_texture(const Player& p) const { return tex[facing_sector(p.aim())]; }
+
+    // draw player + gun
+    void draw(SDL_Renderer* r, const Vec2& pos, const Player& p) const {
+        const Vec2 aimDir = p.aim();
+        SDL_Texture* t = pick_texture(p);
+        if (t) {
+            float tw = 0.f, th = 0.f; SDL_GetTextureSize(t, &tw, &th);
+            float s = scale;
+            SDL_FRect dst{ pos.x - (tw * s) / 2.f, pos.y - (th * s) / 2.f, tw * s, th * s };
+            render_texture(r, t, nullptr, &dst);
+        }
+        else {
+            const float R = Player::RADIUS;
+            SDL_FRect rect{ pos.x - R, pos.y - R, R * 2, R * 2 };
+            SDL_SetRenderDrawColor(r, 120, 170, 255, 255); render_fill_rect(r, &rect);
+        }
+
+        // gun
+        SDL_Texture* g = gun[p.weapon_index()];
+        if (g) {
+            float gw = 0.f, gh = 0.f; SDL_GetTextureSize(g, &gw, &gh);
+            const float TARGET_H = 22.f;
+            float s = TARGET_H / gh;
+
+            SDL_FRect gd{
+                pos.x - (gw * s) / 2.f + aimDir.x * 8.f,
+                pos.y - (gh * s) / 2.f + aimDir.y * 8.f,
+                gw * s, gh * s
+            };
+
+            float angle = std::atan2(aimDir.y, aimDir.x) * 180.0f / PI;
+            SDL_FPoint center{ gd.w / 2.f, gd.h / 2.f };
+            render_texture_rotated(r, g, nullptr, &gd, angle, &center, SDL_FLIP_NONE);
+        }
+    }
+};
@@ -0,0 +1,162 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "vec2.h"
+
+// Grid flow field toward a single goal (the player).
+// One Dijkstra wavefront per rebuild (8-connected, octile costs, no corner
+// cutting), then every cell stores a downhill direction. Zombies just sample
+// the field at their position, so pathfinding cost doesn't grow with the horde.
+// The field only depends on the goal's cell, so while the player moves inside
+// a cell nothing is recomputed; the last stretch inside the goal cell is a
+// straight seek.
+class FlowField {
+public:
+    void reset(float worldW, float worldH, float cell) {
+        cellSize = cell;
+        invCell = 1.f / cell;
+        cols = std::max(1, (int)std::ceil(worldW * invCell));
+        rows = std::max(1, (int)std::ceil(worldH * invCell));
+        size_t n = (size_t)cols * rows;
+        blocked.assign(n, 0);
+        dist.assign(n, UNREACHED);
+        dir.assign(n, Vec2{});
+        goalCell = -1;
+        dirty = true;
+    }
+
+    void set_blocked(int cx, int cy, bool b) {
+        if (cx < 0 || cy < 0 || cx >= cols || cy >= rows) return;
+        blocked[cell_index(cx, cy)] = b ? 1 : 0;
+        dirty = true;
+    }
+
+    // returns true if the field was rebuilt
+    bool update(const Vec2& goal) {
+        int g = cell_index(cell_x(goal.x), cell_y(goal.y));
+        if (g == goalCell && !dirty) return false;
+        goalCell = g;
+        dirty = false;
+        build();
+        rebuilds++;
+        return true;
+    }
+
+    // unit direction to walk from p; straight at the goal when in its cell
+    // or when p can't reach it through the field
+    Vec2 direction(const Vec2& p, const Vec2& goal) const {
+        int cx = cell_x(p.x), cy = cell_y(p.y);
+        int c = cell_index(cx, cy);
+        if (c == goalCell || dist[c] == UNREACHED) return (goal - p).normalized();
+
+        // bilinear blend of the four surrounding cell centres
+        float fx = p.x * invCell - 0.5f, fy = p.y * invCell - 0.5f;
+        int x0 = (int)std::floor(fx), y0 = (int)std::floor(fy);
+        float tx = fx - (float)x0, ty = fy - (float)y0;
+        Vec2 sum{ 0,0 };
+        for (int j = 0; j < 2; j++) {
+            for (int i = 0; i < 2; i++) {
+                int x = x0 + i, y = y0 + j;
+                if (x < 0 || y < 0 || x >= cols || y >= rows) continue;
+                int k = cell_index(x, y);
+                if (blocked[k] || dist[k] == UNREACHED) continue;
+                float w = (i ? tx : 1.f - tx) * (j ? ty : 1.f - ty);
+                sum += dir[k] * w;
+            }
+        }
+        Vec2 d = sum.normalized();
+        return (d.x != 0.f || d.y != 0.f) ? d : dir[c];
+    }
+
+    float cell_size() const { return cellSize; }
+    int   columns() const { return cols; }
+    int   row_count() const { return rows; }
+    int   rebuild_count() const { return rebuilds; }
+
+private:
+    static constexpr int UNREACHED = INT_MAX;
+    static constexpr int COST_ORTHO = 10;
+    static constexpr int COST_DIAG = 14;
+
+    float cellSize{ 1.f }, invCell{ 1.f };
+    int cols{ 1 }, rows{ 1 };
+    std::vector<uint8_t> blocked;
+    std::vector<int> dist;
+    std::vector<Vec2> dir;
+    int goalCell{ -1 };
+    bool dirty{ true };
+    int rebuilds{ 0 };
+
+    // (distance, cell) min-heap, storage kept between rebuilds
+    std::vector<std::pair<int, int>> heap;
+
+    int cell_x(float x) const { return std::clamp((int)std::floor(x * invCell), 0, cols - 1); }
+    int cell_y(float y) const { return std::clamp((int)std::floor(y * invCell), 0, rows - 1); }
+    int cell_index(int cx, int cy) const { return cy * cols + cx; }
+
+    bool open(int x, int y) const {
+        return x >= 0 && y >= 0 && x < cols && y < rows && !blocked[cell_index(x, y)];
+    }
+
+    template<typename Fn>
+    void for_each_step(int x, int y, Fn fn) const {
+        for (int oy = -1; oy <= 1; oy++) {
+            for (int ox = -1; ox <= 1; ox++) {
+                if (!ox && !oy) continue;
+                int nx = x + ox, ny = y + oy;
+                if (!open(nx, ny)) continue;
+                // no squeezing diagonally past a blocked corner
+                if (ox && oy && (!open(x + ox, y) || !open(x, y + oy))) continue;
+                fn(nx, ny, ox, oy, (ox && oy) ? COST_DIAG : COST_ORTHO);
+            }
+        }
+    }
+
+    void build() {
+        std::fill(dist.begin(), dist.end(), UNREACHED);
+        std::fill(dir.begin(), dir.end(), Vec2{});
+        heap.clear();
+        if (blocked[goalCell]) return;
+
+        auto later = std::greater<std::pair<int, int>>();
+        dist[goalCell] = 0;
+        heap.push_back({ 0, goalCell });
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [d, c] = heap.back();
+            heap.pop_back();
+            if (d > dist[c]) continue;
+            for_each_step(c % cols, c / cols, [&](int nx, int ny, int, int, int cost) {
+                int n = cell_index(nx, ny);
+                if (d + cost < dist[n]) {
+                    dist[n] = d + cost;
+                    heap.push_back({ dist[n], n });
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            });
+        }
+
+        // downhill direction: every reachable neighbour closer to the goal
+        // pulls proportionally to how much closer it is, which smooths out
+        // the 8-way staircase you get from "step to the best neighbour"
+        for (int y = 0; y < rows; y++) {
+            for (int x = 0; x < cols; x++) {
+                int c = cell_index(x, y);
+                if (dist[c] == UNREACHED || c == goalCell) continue;
+                Vec2 pull{ 0,0 };
+                for_each_step(x, y, [&](int nx, int ny, int ox, int oy, int cost) {
+                    int dn = dist[cell_index(nx, ny)];
+                    if (dn >= dist[c]) return;
+                    float drop = float(dist[c] - dn) / float(cost);
+                    pull += Vec2{ (float)ox, (float)oy }.normalized() * drop;
+                });
+                dir[c] = pull.normalized();
+            }
+        }
+    }
+};
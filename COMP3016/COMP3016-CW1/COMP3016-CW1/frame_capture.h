@@ -0,0 +1,151 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frame capture: the render thread only reads the frame back into a pooled
+// buffer, PNG encoding and disk writes happen on a worker thread.
+// If every buffer is still waiting on the encoder the frame is dropped, so
+// Game::draw() never blocks on disk. The pool keeps the copy, the queue and
+// the encode from allocating, but SDL3's SDL_RenderReadPixels hands back a
+// new surface every time (there's no read-into-buffer call), so each
+// captured frame still costs that one SDL allocation and free.
+class FrameCapture {
+public:
+    explicit FrameCapture(std::string outDir = "captures", int poolSize = 4)
+        : dir(std::move(outDir)), nextIndex(first_free_index(dir))
+    {
+        for (int i = 0; i < poolSize; i++) freeFrames.push_back(std::make_unique<Frame>());
+        worker = std::thread([this] { run(); });
+    }
+
+    ~FrameCapture() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            quit = true;
+        }
+        cv.notify_one();
+        if (worker.joinable()) worker.join();
+    }
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // single-shot: grab the next frame only
+    void request_single() { pendingSingle = true; }
+
+    // continuous: grab every frame until switched off
+    void set_continuous(bool on) { continuousMode = on; }
+    void toggle_continuous() { continuousMode = !continuousMode; }
+    bool continuous() const { return continuousMode; }
+
+    int captured() const { return capturedCount; }
+    int dropped() const { return droppedCount; }
+
+    // call after the frame is drawn and before SDL_RenderPresent
+    void capture(SDL_Renderer* r) {
+        if (!pendingSingle && !continuousMode) return;
+        pendingSingle = false;
+
+        std::unique_ptr<Frame> f;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (!freeFrames.empty()) { f = std::move(freeFrames.back()); freeFrames.pop_back(); }
+        }
+        if (!f) { droppedCount++; return; } // encoder is behind, skip the readback too
+
+        // allocated by SDL on every call, freed once copied into the pool
+        SDL_Surface* s = SDL_RenderReadPixels(r, nullptr);
+        if (!s) { release(std::move(f)); droppedCount++; return; }
+
+        // keep the pooled buffer's capacity, only its first capture allocates
+        f->w = s->w; f->h = s->h; f->pitch = s->pitch; f->format = s->format;
+        f->pixels.resize((size_t)s->pitch * (size_t)s->h);
+        std::memcpy(f->pixels.data(), s->pixels, f->pixels.size());
+        SDL_DestroySurface(s);
+        f->index = nextIndex++;
+
+        {
+            std::lock_guard<std::mutex> lock(m);
+            queue.push_back(std::move(f));
+        }
+        cv.notify_one();
+        capturedCount++;
+    }
+
+private:
+    struct Frame {
+        std::vector<Uint8> pixels;
+        int w{}, h{}, pitch{};
+        SDL_PixelFormat format{ SDL_PIXELFORMAT_UNKNOWN };
+        int index{};
+    };
+
+    std::string dir;
+    std::thread worker;
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::unique_ptr<Frame>> queue;
+    std::vector<std::unique_ptr<Frame>> freeFrames;
+    bool quit{ false };
+
+    // render thread only
+    bool pendingSingle{ false };
+    bool continuousMode{ false };
+    int  nextIndex{ 0 };            // after the last frame already in dir
+    int  capturedCount{ 0 };
+    int  droppedCount{ 0 };
+
+    // numbering carries on from earlier sessions instead of overwriting them
+    static int first_free_index(const std::string& dir) {
+        int count = 0, next = 0;
+        char** names = SDL_GlobDirectory(dir.c_str(), "frame_*.png", 0, &count);
+        for (int i = 0; names && i < count; i++) {
+            int n = 0;
+            char tail = 0;
+            if (std::sscanf(names[i], "frame_%d.pn%c", &n, &tail) == 2 && tail == 'g' && n >= next) next = n + 1;
+        }
+        SDL_free(names);
+        return next;
+    }
+
+    void release(std::unique_ptr<Frame> f) {
+        std::lock_guard<std::mutex> lock(m);
+        freeFrames.push_back(std::move(f));
+    }
+
+    void run() {
+        SDL_CreateDirectory(dir.c_str());
+        for (;;) {
+            std::unique_ptr<Frame> f;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [this] { return quit || !queue.empty(); });
+                if (queue.empty()) return; // quit, everything queued is written
+                f = std::move(queue.front()); queue.pop_front();
+            }
+            write_png(*f);
+            release(std::move(f));
+        }
+    }
+
+    void write_png(Frame& f) const {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "/frame_%05d.png", f.index);
+        std::string path = dir + name;
+        SDL_Surface* s = SDL_CreateSurfaceFrom(f.w, f.h, f.format, f.pixels.data(), f.pitch);
+        if (!s) return;
+        if (!IMG_SavePNG(s, path.c_str())) SDL_Log("capture: failed to write %s: %s", path.c_str(), SDL_GetError());
+        SDL_DestroySurface(s);
+    }
+};
@@ -0,0 +1,190 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "core.h"
+#include "entities.h"
+#include "frame_capture.h"
+#include "input.h"
+#include "render_stats.h"
+#include "replay.h"
+#include "simulation.h"
+#include "text.h"
+
+// Game: the SDL frontend over Simulation (simulation.h). Turns SDL events
+// and keyboard/mouse state into a SimInput per tick, and draws the
+// simulation's state with the sprites it owns.
+class Game {
+public:
+    // see Simulation for dc
+    Game(SDL_Renderer* ren, SDL_Window* win, int w, int h, const DeterminismConfig& dc = {})
+        : r(ren), window(win), width(w), height(h), det(dc),
+        simulation(std::make_unique<Simulation>(w, h, dc))
+    {
+        // decoded on the workers, uploaded here
+        TextureBatch textures;
+        textures.add(&background, "data/map.png", "data/assets/map.png", "map.png");
+        playerSprites.load(textures);
+        zombieSprites.load(textures);
+        textures.load(r, simulation->job_system());
+        show_wave_title();
+    }
+
+    ~Game() {
+        destroy_texture(background);
+        playerSprites.destroy();
+        zombieSprites.destroy();
+    }
+
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
+
+    Simulation& sim() { return *simulation; }
+    const Simulation& sim() const { return *simulation; }
+
+    // a new game in place of this one (soak tests); the textures stay, a
+    // deterministic run moves on to the next seed
+    void restart() {
+        if (det.enabled) det.seed++;
+        simulation.reset();
+        simulation = std::make_unique<Simulation>(width, height, det);
+        gameOverAnim = 0.f;
+        show_wave_title();
+    }
+
+    // every SimInput that reaches the simulation also goes to rec, null = off
+    void record_to(InputRecorder* rec) { recorder = rec; }
+
+    // clicks and weapon keys are held until the next update()
+    void handle_event(const SDL_Event& e) {
+        if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN && e.button.button == SDL_BUTTON_LEFT) queuedShoot = true;
+        if (e.type == SDL_EVENT_KEY_DOWN) {
+            if (e.key.key == SDLK_1) queuedWeapon = 0;
+            if (e.key.key == SDLK_2) queuedWeapon = 1;
+            if (e.key.key == SDLK_3) queuedWeapon = 2;
+            if (e.key.key == SDLK_F12) capture.request_single();
+            if (e.key.key == SDLK_F11) capture.toggle_continuous();
+        }
+    }
+
+    // one simulation tick with the current keyboard/mouse state
+    void update(float dt, const bool* kstate, float mx, float my) {
+        SimInput in;
+        in.up = kstate[SDL_SCANCODE_W];
+        in.down = kstate[SDL_SCANCODE_S];
+        in.left = kstate[SDL_SCANCODE_A];
+        in.right = kstate[SDL_SCANCODE_D];
+        in.aim = Vec2{ mx, my };
+        in.shoot = queuedShoot;
+        in.weapon = queuedWeapon;
+        queuedShoot = false;
+        queuedWeapon = -1;
+        update(dt, in);
+    }
+
+    // one simulation tick with input from elsewhere (bots, replays)
+    void update(float dt, const SimInput& in) {
+        const bool wasOver = simulation->game_over();
+        if (recorder) recorder->add(in);
+        simulation->step(dt, in);
+        if (!wasOver && simulation->game_over()) gameOverAnim = 2.0f;
+        else if (simulation->game_over()) gameOverAnim = std::max(0.f, gameOverAnim - dt);
+        if (simulation->wave() != shownWave) show_wave_title();
+    }
+
+    void draw() const {
+        if (background) {
+            SDL_FRect dst{ 0,0,(float)width,(float)height };
+            render_texture(r, background, nullptr, &dst);
+        }
+        else {
+            SDL_SetRenderDrawColor(r, 18, 14, 22, 255); render_clear(r);
+        }
+
+        SDL_SetRenderDrawColor(r, 60, 50, 80, 255);
+        SDL_FRect border{ 10,10,(float)width - 20,(float)height - 20 }; render_rect(r, &border);
+
+        for (const Obstacle& o : simulation->obstacle_list()) {
+            SDL_FRect rect{ o.x, o.y, o.w, o.h };
+            if (o.kind == Obstacle::Crate) SDL_SetRenderDrawColor(r, 120, 84, 48, 255);
+            else SDL_SetRenderDrawColor(r, 70, 66, 82, 255);
+            render_fill_rect(r, &rect);
+        }
+
+        playerSprites.draw(r, simulation->player_position(), simulation->player_state());
+        draw_zombies(r, simulation->zombie_rows(), zombieSprites);
+        draw_bullets(r, simulation->bullet_rows());
+
+        draw_hud();
+
+        capture.capture(r);
+        SDL_RenderPresent(r);
+    }
+
+    void draw_hud() const {
+        // Wave
+        draw_text(r, 16.f, 10.f, "WAVE " + std::to_string(simulation->wave()), 2.0f, SDL_Color{ 255,220,120,255 });
+
+        // Health
+        for (int i = 0; i < simulation->player_hp(); i++) {
+            SDL_FRect hp{ 16.f + i * 16.f, 28.f, 10.f, 10.f };
+            SDL_SetRenderDrawColor(r, 255, 90, 90, 255);
+            render_fill_rect(r, &hp);
+        }
+
+        // Ammo (current weapon)
+        const Weapon& w = simulation->player_state().current();
+        int ammo = simulation->player_state().current_ammo();
+        std::string ammoText = w.name + std::string(" ") + (ammo < 0 ? "INF" : std::to_string(ammo));
+        draw_text(r, 16.f, 44.f, ammoText, 2.0f, SDL_Color{ 190,240,255,255 });
+
+        // Wave progress bar (bottom)
+        float pct = simulation->wave_progress();
+        float barW = (float)width - 40.f;
+        SDL_FRect bg{ 20.f, (float)height - 18.f, barW, 6.f };
+        SDL_SetRenderDrawColor(r, 40, 40, 60, 180); render_fill_rect(r, &bg);
+        SDL_FRect fg{ 20.f, (float)height - 18.f, barW * std::clamp(pct,0.f,1.f), 6.f };
+        SDL_SetRenderDrawColor(r, 120, 230, 120, 255); render_fill_rect(r, &fg);
+
+        if (simulation->game_over() && gameOverAnim > 0.f) {
+            Uint8 a = (Uint8)std::clamp(gameOverAnim / 2.f * 200.f, 0.f, 200.f);
+            SDL_SetRenderDrawColor(r, 220, 40, 40, a);
+            SDL_FRect f{ 0,0,(float)width,(float)height }; render_fill_rect(r, &f);
+        }
+    }
+
+private:
+    // SDL
+    SDL_Renderer* r{};
+    SDL_Window* window{};
+    int width{}, height{};
+    SDL_Texture* background{};
+    PlayerSprites playerSprites;
+    ZombieSprites zombieSprites;
+
+    DeterminismConfig det;
+    std::unique_ptr<Simulation> simulation;
+
+    // input waiting for the next update()
+    bool queuedShoot{ false };
+    int queuedWeapon{ -1 };
+    InputRecorder* recorder{};
+
+    // fx
+    float gameOverAnim{ 0.f };
+    int shownWave{ 0 };
+
+    // screenshots (F12) / continuous capture (F11)
+    mutable FrameCapture capture;
+
+    void show_wave_title() {
+        shownWave = simulation->wave();
+        if (!window) return;
+        std::string t = "COMP3016 CW1 - Top-Down Zombies  |  Wave " + std::to_string(shownWave);
+        SDL_SetWindowTitle(window, t.c_str());
+    }
+};
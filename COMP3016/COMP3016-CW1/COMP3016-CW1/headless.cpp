@@ -0,0 +1,188 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <string>
+
+#include "bot.h"
+#include "replay.h"
+#include "simulation.h"
+#include "soak.h"
+
+// Headless runner: steps the simulation (no SDL, no window) as fast as the
+// CPU allows with scripted input (walk a square, aim around the player,
+// fire every tick), then prints ticks/sec and where the run ended up. Stops
+// early if the player dies. Run from the project directory so data/ is
+// found.
+//
+// --ticks N      ticks to run (default 36000, ten minutes of game time)
+// --seed N       deterministic mode with this seed (hash printed at the end)
+// --tick SEC     fixed tick (default 1/60)
+// --threads N    job system threads, 0 = one per hardware thread
+// --scene N      start from N zombies scattered over the arena
+// --bot          the bot (bot.h) plays instead of the script
+// --soak MIN     soak test: the bot plays back-to-back games for MIN
+//                minutes of wall time, CSV rows on stdout (soak.h); a
+//                "frame" is 60 ticks
+// --soak-interval SEC   seconds per soak row (default 60)
+// --record FILE  record every tick's input (replay.h); implies --seed
+// --replay FILE  play a recording back uncapped instead, check it ends in
+//                the recorded state (exit 1 if not) and print the speed
+// --hash-log F   write "tick hash" per tick to F (deterministic mode)
+
+static const int WIDTH = 960, HEIGHT = 540;
+
+static SimInput scripted_input(uint64_t t, const Vec2& player) {
+    SimInput in;
+    switch ((t / 45) % 4) {
+    case 0: in.right = true; break;
+    case 1: in.down = true; break;
+    case 2: in.left = true; break;
+    default: in.up = true; break;
+    }
+    float a = (float)(t % 1000) * 0.05f;
+    in.aim = player + Vec2{ std::cos(a), std::sin(a) } * 200.f;
+    in.shoot = true;
+    if (t % 300 == 0) in.weapon = (int)(t / 300) % 3;
+    return in;
+}
+
+// a recording as fast as it goes; 1 if it doesn't end where it should
+static int run_replay(const std::string& path, int threads, const std::string& hashLog) {
+    ReplayReader rec;
+    if (!rec.open(path)) {
+        std::fprintf(stderr, "%s\n", rec.error().c_str());
+        return 2;
+    }
+    const ReplayHeader& h = rec.header();
+    if (h.width != WIDTH || h.height != HEIGHT) {
+        std::fprintf(stderr, "recorded at %dx%d, the simulation is %dx%d\n", h.width, h.height, WIDTH, HEIGHT);
+        return 2;
+    }
+    DeterminismConfig det;
+    det.enabled = true;
+    det.seed = h.seed;
+    det.tick = h.tick;
+    det.hashLog = hashLog;
+    Simulation sim(WIDTH, HEIGHT, det, threads);
+
+    auto t0 = std::chrono::steady_clock::now();
+    SimInput in;
+    while (rec.next(in)) sim.step(h.tick, in);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const double gameSec = (double)rec.ticks_read() * h.tick;
+    std::printf("ticks         %" PRIu64 "\n", rec.ticks_read());
+    std::printf("seconds       %.3f\n", sec);
+    std::printf("ticks/sec     %.1f\n", sec > 0.0 ? rec.ticks_read() / sec : 0.0);
+    std::printf("speed         %.0fx real time\n", sec > 0.0 ? gameSec / sec : 0.0);
+    std::printf("wave          %d\n", sim.wave());
+    std::printf("score         %d\n", sim.score_value());
+    std::printf("state hash    %016" PRIx64 "\n", sim.last_hash());
+    if (!rec.has_trailer()) {
+        std::printf("recording has no trailer (cut short), not checked\n");
+        return 0;
+    }
+    const bool ok = rec.recorded_ticks() == rec.ticks_read() && rec.recorded_hash() == sim.last_hash();
+    std::printf("recorded      %016" PRIx64 " after %" PRIu64 " ticks: %s\n", rec.recorded_hash(), rec.recorded_ticks(),
+        ok ? "match" : "MISMATCH");
+    return ok ? 0 : 1;
+}
+
+// back-to-back bot games until the soak time is up; 1 if it found a leak
+static int run_soak(DeterminismConfig det, int threads, const SoakConfig& cfg) {
+    const int BATCH = 60;
+    det.enabled = true;             // seeded games, the next seed every restart
+    auto sim = std::make_unique<Simulation>(WIDTH, HEIGHT, det, threads);
+    Bot bot(BotConfig{}, det.seed);
+    SoakMonitor soak(cfg, stdout);
+    int games = 1;
+    while (!soak.done()) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < BATCH; k++) {
+            if (sim->game_over()) {
+                det.seed++;
+                sim.reset();
+                sim = std::make_unique<Simulation>(WIDTH, HEIGHT, det, threads);
+                games++;
+            }
+            sim->step(sim->fixed_tick(), bot.think(*sim));
+        }
+        soak.frame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        soak.poll(-1, games, sim->zombie_count());
+    }
+    return soak.finish(-1, games, sim->zombie_count());
+}
+
+int main(int argc, char* argv[]) {
+    long long ticks = 36000;
+    int threads = 0, scene = 0;
+    bool useBot = false;
+    DeterminismConfig det;
+    SoakConfig soak;
+    std::string recordPath, replayPath;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--bot")) { useBot = true; continue; }
+        if (i + 1 == argc) {
+            std::fprintf(stderr, "missing value for %s\n", argv[i]);
+            return 2;
+        }
+        if (!std::strcmp(argv[i], "--ticks")) ticks = std::max(1LL, std::atoll(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed")) { det.enabled = true; det.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10); }
+        else if (!std::strcmp(argv[i], "--tick")) det.tick = std::max(0.001f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--threads")) threads = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--scene")) scene = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--soak")) soak.minutes = std::max(0.0, std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--soak-interval")) soak.intervalSec = std::max(1.0, std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--record")) recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay")) replayPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--hash-log")) det.hashLog = argv[++i];
+    }
+    if (!replayPath.empty()) return run_replay(replayPath, threads, det.hashLog);
+    if (soak.minutes > 0.0) return run_soak(det, threads, soak);
+
+    InputRecorder recorder;
+    if (!recordPath.empty()) {
+        if (scene > 0) {
+            std::fprintf(stderr, "--scene can't be recorded, only input is\n");
+            return 2;
+        }
+        det.enabled = true;
+        if (!recorder.open(recordPath, ReplayHeader{ det.seed, det.tick, WIDTH, HEIGHT })) {
+            std::fprintf(stderr, "can't write %s\n", recordPath.c_str());
+            return 2;
+        }
+    }
+
+    Simulation sim(WIDTH, HEIGHT, det);
+    if (threads > 0) sim.set_worker_threads(threads);
+    if (scene > 0) sim.load_scene(scene, 0, det.enabled ? det.seed : 1);
+    const float dt = det.enabled ? sim.fixed_tick() : 1.f / 60.f;
+
+    Bot bot(BotConfig{}, det.seed);
+    auto t0 = std::chrono::steady_clock::now();
+    long long ran = 0;
+    for (; ran < ticks && !sim.game_over(); ran++) {
+        const SimInput in = useBot ? bot.think(sim) : scripted_input(sim.tick(), sim.player_position());
+        recorder.add(in);
+        sim.step(dt, in);
+    }
+    recorder.finish(sim.last_hash());
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::printf("ticks         %lld%s\n", ran, sim.game_over() ? " (player died)" : "");
+    std::printf("seconds       %.3f\n", sec);
+    std::printf("ticks/sec     %.1f\n", sec > 0.0 ? ran / sec : 0.0);
+    std::printf("game time     %.1f s\n", sim.survive_time());
+    std::printf("wave          %d\n", sim.wave());
+    std::printf("score         %d\n", sim.score_value());
+    std::printf("zombies       %d\n", sim.zombie_count());
+    std::printf("threads       %d\n", sim.worker_threads());
+    std::printf("state hash    %016" PRIx64 "\n", sim.state_hash());
+    return 0;
+}
@@ -0,0 +1,12 @@
+﻿#pragma once
+
+#include "vec2.h"
+
+// One tick of player input, whatever produced it: the SDL frontend maps
+// keyboard and mouse onto this, tools and tests fill it in directly.
+struct SimInput {
+    bool up{ false }, down{ false }, left{ false }, right{ false };
+    Vec2 aim{};             // point the player aims at
+    bool shoot{ false };    // fire once this tick if the weapon is ready
+    int  weapon{ -1 };      // switch to 0..2 first, -1 = keep
+};
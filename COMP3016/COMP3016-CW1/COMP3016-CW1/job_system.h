@@ -0,0 +1,264 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Work-stealing job system shared by the game and tools.
+// Every thread has its own deque: it pushes and pops its own jobs at the
+// back (newest first, still warm in cache) and idle threads steal from the
+// front of someone else's. Threads that aren't workers (the main thread,
+// a Schedule caller) share queue 0. Waiting never blocks a thread that
+// could be working: wait() runs queued jobs until its counter drains, so
+// jobs may spawn and wait on jobs of their own.
+//
+//   spawn/wait     fire jobs against a JobCounter, wait for it to hit zero
+//   parallel_for   [0, n) in chunks of exactly `grain` (k = begin / grain)
+//   TaskGraph      jobs with dependencies, run() returns when all are done
+//   post_main      jobs that must run on the main thread (SDL renderer
+//                  calls); the main thread runs them in run_main() or while
+//                  it waits
+//
+// The thread that constructs the JobSystem is its main thread.
+
+struct JobCounter {
+    std::atomic<int> n{ 0 };
+    bool done() const { return n.load(std::memory_order_acquire) == 0; }
+};
+
+class TaskGraph;
+
+class JobSystem {
+public:
+    using Fn = std::function<void()>;
+
+    // threads counts the main thread; 0 = one per hardware thread.
+    // init runs first on every worker (e.g. enter_deterministic_fp).
+    explicit JobSystem(int threads = 0, Fn init = {}) : mainThread(std::this_thread::get_id()) {
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+        for (int i = 1; i < threads; i++)
+            workers.emplace_back([this, i, init] {
+                self() = { this, i };
+                if (init) init();
+                work(i);
+            });
+    }
+
+    ~JobSystem() {
+        quit.store(true);
+        { std::lock_guard<std::mutex> lock(sleepM); }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int thread_count() const { return (int)queues.size(); }
+    bool on_main_thread() const { return std::this_thread::get_id() == mainThread; }
+
+    void spawn(Fn fn, JobCounter& c) {
+        c.n.fetch_add(1, std::memory_order_relaxed);
+        push(Job{ std::move(fn), &c });
+    }
+
+    // runs other jobs (and main-thread jobs, on the main thread) meanwhile
+    void wait(JobCounter& c) {
+        while (!c.done()) {
+            if (!run_one(local_index())) std::this_thread::yield();
+        }
+    }
+
+    template<typename F>
+    void parallel_for(int n, int grain, F&& fn) {
+        if (n <= 0) return;
+        grain = std::max(1, grain);
+        const int chunks = (n + grain - 1) / grain;
+        if (chunks == 1 || thread_count() == 1) {
+            for (int b = 0; b < n; b += grain) fn(b, std::min(n, b + grain));
+            return;
+        }
+        // spawned back to front, so the owner pops chunk 1 first and
+        // thieves take the far end
+        JobCounter c;
+        for (int k = chunks - 1; k >= 1; k--) {
+            int b = k * grain, e = std::min(n, b + grain);
+            spawn([&fn, b, e] { fn(b, e); }, c);
+        }
+        fn(0, std::min(n, grain));
+        wait(c);
+    }
+
+    // blocks until every task in the graph has run
+    void run(TaskGraph& g);
+
+    void post_main(Fn fn, JobCounter* c = nullptr) {
+        if (c) c->n.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mainM);
+        mainJobs.push_back(Job{ std::move(fn), c });
+    }
+
+    // main thread only: run what post_main() queued so far, returns how many
+    int run_main() {
+        std::deque<Job> batch;
+        {
+            std::lock_guard<std::mutex> lock(mainM);
+            batch.swap(mainJobs);
+        }
+        for (Job& j : batch) execute(j);
+        return (int)batch.size();
+    }
+
+private:
+    struct Job {
+        Fn fn;
+        JobCounter* counter{};
+    };
+
+    struct alignas(64) Queue {
+        std::mutex m;
+        std::deque<Job> jobs;
+    };
+
+    struct Self { JobSystem* sys{}; int index{ 0 }; };
+    static Self& self() { thread_local Self s; return s; }
+
+    std::thread::id mainThread;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> quit{ false };
+
+    // idle workers sleep until something is queued
+    std::atomic<int> queued{ 0 }, sleeping{ 0 };
+    std::mutex sleepM;
+    std::condition_variable wake;
+
+    std::mutex mainM;
+    std::deque<Job> mainJobs;
+
+    int local_index() const { return self().sys == this ? self().index : 0; }
+
+    void push(Job&& j) {
+        Queue& q = *queues[local_index()];
+        queued.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(q.m);
+            q.jobs.push_back(std::move(j));
+        }
+        if (sleeping.load() > 0) {
+            { std::lock_guard<std::mutex> lock(sleepM); }
+            wake.notify_one();
+        }
+    }
+
+    bool pop_back(int i, Job& out) {
+        Queue& q = *queues[i];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.jobs.empty()) return false;
+        out = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        return true;
+    }
+
+    bool steal_front(int i, Job& out) {
+        Queue& q = *queues[i];
+        std::unique_lock<std::mutex> lock(q.m, std::try_to_lock);
+        if (!lock.owns_lock() || q.jobs.empty()) return false;
+        out = std::move(q.jobs.front());
+        q.jobs.pop_front();
+        return true;
+    }
+
+    // own queue, then main-thread jobs (main thread only), then steal
+    bool run_one(int me) {
+        Job j;
+        if (pop_back(me, j)) { queued.fetch_sub(1); execute(j); return true; }
+        if (on_main_thread() && run_main() > 0) return true;
+        const int n = thread_count();
+        for (int k = 1; k < n; k++) {
+            if (steal_front((me + k) % n, j)) { queued.fetch_sub(1); execute(j); return true; }
+        }
+        return false;
+    }
+
+    static void execute(Job& j) {
+        j.fn();
+        if (j.counter) j.counter->n.fetch_sub(1, std::memory_order_release);
+    }
+
+    void work(int me) {
+        int idle = 0;
+        while (!quit.load(std::memory_order_relaxed)) {
+            if (run_one(me)) { idle = 0; continue; }
+            if (++idle < 64) { std::this_thread::yield(); continue; }
+            sleeping.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(sleepM);
+                wake.wait(lock, [&] { return quit.load() || queued.load() > 0; });
+            }
+            sleeping.fetch_sub(1);
+            idle = 0;
+        }
+    }
+
+    friend class TaskGraph;
+};
+
+// Jobs with dependencies: add() the tasks, precede(a, b) for "b after a",
+// then JobSystem::run(). Tasks marked main run on the main thread (which
+// must be the one calling run()). A graph can be run again once finished.
+class TaskGraph {
+public:
+    int add(JobSystem::Fn fn, bool mainThread = false) {
+        nodes.emplace_back();
+        nodes.back().fn = std::move(fn);
+        nodes.back().main = mainThread;
+        return (int)nodes.size() - 1;
+    }
+
+    void precede(int before, int after) {
+        nodes[before].next.push_back(after);
+        nodes[after].deps++;
+    }
+
+    int size() const { return (int)nodes.size(); }
+
+private:
+    struct Node {
+        JobSystem::Fn fn;
+        std::vector<int> next;
+        int deps{ 0 };
+        std::atomic<int> pending{ 0 };
+        bool main{ false };
+    };
+    std::deque<Node> nodes;     // stable addresses for the atomics
+
+    void schedule(JobSystem& js, int i, JobCounter& c) {
+        auto body = [this, &js, i, &c] {
+            nodes[i].fn();
+            for (int s : nodes[i].next)
+                if (nodes[s].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) schedule(js, s, c);
+        };
+        if (nodes[i].main) js.post_main(body, &c);
+        else js.spawn(body, c);
+    }
+
+    friend class JobSystem;
+};
+
+inline void JobSystem::run(TaskGraph& g) {
+    JobCounter c;
+    for (TaskGraph::Node& n : g.nodes) n.pending.store(n.deps, std::memory_order_relaxed);
+    for (int i = 0; i < g.size(); i++)
+        if (g.nodes[i].deps == 0) g.schedule(*this, i, c);
+    wait(c);
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Resident memory of this process, for the stress and soak reports.
+// Both return 0 where the platform can't tell.
+
+// peak resident set so far
+inline uint64_t peak_memory_bytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return (uint64_t)pmc.PeakWorkingSetSize;
+    return 0;
+#else
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#if defined(__APPLE__)
+    return (uint64_t)ru.ru_maxrss;          // bytes
+#else
+    return (uint64_t)ru.ru_maxrss * 1024;   // KiB
+#endif
+#endif
+}
+
+// resident set right now
+inline uint64_t current_memory_bytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return (uint64_t)pmc.WorkingSetSize;
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+    return (uint64_t)info.resident_size;
+#else
+    // /proc/self/statm: total and resident pages
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long long pages = 0, resident = 0;
+    int got = std::fscanf(f, "%llu %llu", &pages, &resident);
+    std::fclose(f);
+    return got == 2 ? (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
@@ -0,0 +1,141 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <type_traits>
+
+#include "components.h"
+#include "determinism.h"
+#include "input.h"
+#include "vec2.h"
+
+// entities
+// Player, zombies and bullets are archetypes in the ECS world
+// (components.h); these are the simulation-side operations on them.
+// Sprites and drawing live in entities.h.
+
+inline int facing_sector(const Vec2& d) {
+    float a = std::atan2(d.y, d.x); if (a < 0) a += PI * 2.f;
+    return int(std::floor((a + PI / 8.0f) / (PI / 4.0f))) & 7;
+}
+
+// seek: unit direction to walk (e.g. from the flow field)
+// crowd: separation/cohesion offset from crowd_force(), added to the seek
+inline void steer_zombie(ZombieArch& zs, int i, const Vec2& seek, const Vec2& crowd = Vec2{}) {
+    Vec2 dir = (seek + crowd).normalized();
+    zs.get<Velocity>(i).vel = dir * zs.get<AI>(i).speed;
+    if (dir.len() > 0.0001f) zs.get<Sprite>(i).faceDir = dir;
+}
+
+// Player + Weapons
+struct Weapon {
+    std::string name;
+    float fireRate{ 6.f };
+    float bulletSpeed{ 520.f };
+    float bulletLife{ 1.0f };
+    float spreadDeg{ 0.f };
+    int   pellets{ 1 };
+    int   ammo{ -1 };
+};
+
+// Weapons and aim of the player. Position, velocity, radius and hp are
+// components of the player entity (PlayerArch), passed in by Simulation.
+class Player {
+public:
+    static constexpr float RADIUS = 14.f;
+
+    void setup_weapons() {
+        pistol.name = "PST"; shotgun.name = "SG"; rifle.name = "RF";
+        pistol.fireRate = 7.0f; pistol.bulletSpeed = 620.f; pistol.bulletLife = 0.9f; pistol.spreadDeg = 4.f;  pistol.pellets = 1; pistol.ammo = -1; // ∞
+        shotgun.fireRate = 1.2f; shotgun.bulletSpeed = 520.f; shotgun.bulletLife = 0.7f; shotgun.spreadDeg = 22.f; shotgun.pellets = 6; shotgun.ammo = 24;
+        rifle.fireRate = 10.0f; rifle.bulletSpeed = 780.f; rifle.bulletLife = 1.0f; rifle.spreadDeg = 2.0f;  rifle.pellets = 1; rifle.ammo = 90;
+        select = 0;
+    }
+
+    // returns the wanted velocity
+    Vec2 update_input(float dt, const SimInput& in, const Vec2& pos) {
+        Vec2 acc{ 0,0 };
+        if (in.up)    acc.y -= 1;
+        if (in.down)  acc.y += 1;
+        if (in.left)  acc.x -= 1;
+        if (in.right) acc.x += 1;
+        acc = acc.normalized() * speed;
+
+        aimDir = (in.aim - pos).normalized();
+        shootTimer = std::max(0.f, shootTimer - dt);
+        return acc;
+    }
+
+    int try_shoot(const Vec2& pos, BulletArch& out, std::mt19937& rng) {
+        const Weapon& w = current();
+        if (shootTimer > 0.f) return 0;
+        if (current_ammo() == 0) return 0;
+
+        shootTimer = 1.0f / w.fireRate;
+
+        if (select == 1 && shotgunAmmo > 0) shotgunAmmo--;
+        if (select == 2 && rifleAmmo > 0) rifleAmmo--;
+
+        std::uniform_real_distribution<float> jitter(-w.spreadDeg, w.spreadDeg);
+        int emitted = 0;
+        for (int i = 0; i < w.pellets; i++) {
+            float ang = std::atan2(aimDir.y, aimDir.x) + (jitter(rng) * (PI / 180.f));
+            Vec2 dir{ std::cos(ang), std::sin(ang) };
+            if (spawn_bullet(out, pos + dir * 18.f, dir * w.bulletSpeed, w.bulletLife, 4.f) < 0) break;
+            emitted++;
+        }
+        return emitted;
+    }
+
+    // Most bullets that can be alive at once: every weapon firing flat out
+    // for a full bullet lifetime (switching mid-burst can mix them).
+    int max_live_bullets() const {
+        int n = 0;
+        for (const Weapon* w : { &pistol, &shotgun, &rifle })
+            n += ((int)std::ceil(w->fireRate * w->bulletLife) + 1) * w->pellets;
+        return n;
+    }
+
+    // weapon switching 
+    void set_weapon(int idx) { select = std::clamp(idx, 0, 2); }
+
+    // ammo counts for HUD
+    int pistolAmmo{ -1 }; 
+    int shotgunAmmo{ 24 };
+    int rifleAmmo{ 90 };
+
+    int current_ammo() const {
+        if (select == 1) return shotgunAmmo;
+        if (select == 2) return rifleAmmo;
+        return pistolAmmo;
+    }
+
+    const Weapon& current() const { return weapon(select); }
+
+    const Weapon& weapon(int idx) const {
+        if (idx == 1) return shotgun;
+        if (idx == 2) return rifle;
+        return pistol;
+    }
+
+    Vec2 aim() const { return aimDir; }
+    int weapon_index() const { return select; }
+
+    void hash_into(StateHash& h) const {
+        h.add(shootTimer); h.add(aimDir); h.add(select);
+        h.add(pistolAmmo); h.add(shotgunAmmo); h.add(rifleAmmo);
+    }
+
+private:
+    float speed{ 220.f };
+    float shootTimer{ 0.f };
+    Vec2  aimDir{ 1,0 };
+
+    // weapons
+    Weapon pistol, shotgun, rifle;
+    int select{ 0 }; // active weapon
+};
+
+static_assert(!std::is_polymorphic_v<Player>, "Player should not need a vtable");
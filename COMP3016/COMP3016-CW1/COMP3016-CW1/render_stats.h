@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+
+// Draw-call accounting. All game drawing goes through these wrappers so the
+// benchmarks can report how many calls and texture switches a frame costs.
+// A texture switch is any draw whose texture differs from the previous draw
+// (untextured fills count as "no texture"), which is what breaks a batch.
+struct RenderStats {
+    long long drawCalls{ 0 };
+    long long textureSwitches{ 0 };
+    const SDL_Texture* lastTexture{ nullptr };
+
+    void reset() { *this = RenderStats{}; }
+};
+
+inline RenderStats& render_stats() {
+    static RenderStats stats;
+    return stats;
+}
+
+inline void note_draw(const SDL_Texture* t) {
+    RenderStats& s = render_stats();
+    s.drawCalls++;
+    if (t != s.lastTexture) { s.textureSwitches++; s.lastTexture = t; }
+}
+
+// Textures alive right now: load_any() and TextureBatch count what they
+// create, destroy_texture() what goes. The soak test watches it for leaks.
+inline long long& live_textures() {
+    static long long n = 0;
+    return n;
+}
+
+inline SDL_Texture* note_texture_created(SDL_Texture* t) {
+    if (t) live_textures()++;
+    return t;
+}
+
+inline void destroy_texture(SDL_Texture* t) {
+    if (!t) return;
+    live_textures()--;
+    SDL_DestroyTexture(t);
+}
+
+inline bool render_clear(SDL_Renderer* r) {
+    note_draw(nullptr);
+    return SDL_RenderClear(r);
+}
+
+inline bool render_fill_rect(SDL_Renderer* r, const SDL_FRect* rect) {
+    note_draw(nullptr);
+    return SDL_RenderFillRect(r, rect);
+}
+
+inline bool render_rect(SDL_Renderer* r, const SDL_FRect* rect) {
+    note_draw(nullptr);
+    return SDL_RenderRect(r, rect);
+}
+
+inline bool render_texture(SDL_Renderer* r, SDL_Texture* t, const SDL_FRect* src, const SDL_FRect* dst) {
+    note_draw(t);
+    return SDL_RenderTexture(r, t, src, dst);
+}
+
+inline bool render_texture_rotated(SDL_Renderer* r, SDL_Texture* t, const SDL_FRect* src, const SDL_FRect* dst,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip)
+{
+    note_draw(t);
+    return SDL_RenderTextureRotated(r, t, src, dst, angle, center, flip);
+}
@@ -0,0 +1,230 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "input.h"
+
+// Input recording and replay. A deterministic simulation (determinism.h)
+// fed the same SimInputs from the same seed ends in the same state, so a
+// session is just its seed plus one SimInput per tick. The file:
+//
+//   header   "ZRPL", version u16, seed u32, tick f32, width u16, height u16
+//   records  one per tick, a flags byte:
+//              bits 0-3  up, down, left, right
+//              bit 4     shoot
+//              bit 5     aim follows (x, y as f32), else the previous aim
+//              bit 6     weapon follows (u8)
+//            0x80 + varint n: the previous tick's input n more times
+//   trailer  0xFF, ticks u64, final state hash u64
+//
+// Little-endian throughout. Unchanged ticks cost nothing past the run
+// length, a tick with a moved mouse 9 bytes. The recorder flushes every few
+// seconds of game time, so a crash loses little; a file without a trailer
+// still replays, it just can't be checked against the final hash. Replays
+// need the same data/ files and the same build.
+
+struct ReplayHeader {
+    uint32_t seed{ 1 };
+    float tick{ 1.f / 60.f };
+    int width{ 0 }, height{ 0 };
+};
+
+namespace replay_detail {
+    constexpr char MAGIC[4] = { 'Z', 'R', 'P', 'L' };
+    constexpr uint16_t VERSION = 1;
+    constexpr uint8_t AIM = 0x20, WEAPON = 0x40, REPEAT = 0x80, END = 0xFF;
+
+    inline uint32_t float_bits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+    inline float bits_float(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+}
+
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder() { if (f) std::fclose(f); }
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const std::string& path, const ReplayHeader& h) {
+        using namespace replay_detail;
+        f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        buf.insert(buf.end(), MAGIC, MAGIC + 4);
+        put(VERSION, 2); put(h.seed, 4); put(float_bits(h.tick), 4);
+        put((uint32_t)h.width, 2); put((uint32_t)h.height, 2);
+        flush();
+        return true;
+    }
+
+    bool is_open() const { return f != nullptr; }
+    uint64_t ticks() const { return tickCount; }
+
+    // the input of the next tick
+    void add(const SimInput& in) {
+        if (!f) return;
+        tickCount++;
+        if (tickCount > 1 && same(in, last)) { repeats++; return; }
+        end_run();
+        using namespace replay_detail;
+        const bool aim = tickCount == 1 || in.aim.x != last.aim.x || in.aim.y != last.aim.y;
+        uint8_t flags = (in.up ? 1 : 0) | (in.down ? 2 : 0) | (in.left ? 4 : 0) | (in.right ? 8 : 0) |
+            (in.shoot ? 0x10 : 0) | (aim ? AIM : 0) | (in.weapon >= 0 ? WEAPON : 0);
+        buf.push_back(flags);
+        if (aim) { put(float_bits(in.aim.x), 4); put(float_bits(in.aim.y), 4); }
+        if (in.weapon >= 0) buf.push_back((uint8_t)in.weapon);
+        last = in;
+        if (tickCount % 600 == 0) flush();
+    }
+
+    // trailer with the state hash after the last tick, then closes the file
+    void finish(uint64_t finalHash) {
+        if (!f) return;
+        end_run();
+        buf.push_back(replay_detail::END);
+        put(tickCount, 8); put(finalHash, 8);
+        flush();
+        std::fclose(f);
+        f = nullptr;
+    }
+
+private:
+    std::FILE* f{};
+    std::vector<uint8_t> buf;
+    SimInput last;
+    uint64_t tickCount{ 0 };
+    uint64_t repeats{ 0 };
+
+    static bool same(const SimInput& a, const SimInput& b) {
+        return a.up == b.up && a.down == b.down && a.left == b.left && a.right == b.right &&
+            a.shoot == b.shoot && a.weapon == b.weapon && a.aim.x == b.aim.x && a.aim.y == b.aim.y;
+    }
+
+    void put(uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; i++) buf.push_back((uint8_t)(v >> (8 * i)));
+    }
+
+    void end_run() {
+        if (!repeats) return;
+        buf.push_back(replay_detail::REPEAT);
+        for (uint64_t v = repeats; ; v >>= 7) {
+            if (v < 0x80) { buf.push_back((uint8_t)v); break; }
+            buf.push_back((uint8_t)(v & 0x7F) | 0x80);
+        }
+        repeats = 0;
+    }
+
+    void flush() {
+        if (!buf.empty()) std::fwrite(buf.data(), 1, buf.size(), f);
+        std::fflush(f);
+        buf.clear();
+    }
+};
+
+// Reads a whole recording into memory, then hands out one tick at a time.
+class ReplayReader {
+public:
+    // false (with error()) if the file is missing or not a recording
+    bool open(const std::string& path) {
+        using namespace replay_detail;
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return fail("can't open " + path);
+        data.clear();
+        uint8_t chunk[65536];
+        for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0; ) data.insert(data.end(), chunk, chunk + n);
+        std::fclose(f);
+        pos = 0;
+        if (data.size() < 16 || std::memcmp(data.data(), MAGIC, 4) != 0) return fail(path + " is not a recording");
+        pos = 4;
+        if (get(2) != VERSION) return fail(path + ": unsupported version");
+        hdr.seed = (uint32_t)get(4);
+        hdr.tick = bits_float((uint32_t)get(4));
+        hdr.width = (int)get(2);
+        hdr.height = (int)get(2);
+        repeats = 0;
+        tickCount = 0;
+        ended = false;
+        return true;
+    }
+
+    const ReplayHeader& header() const { return hdr; }
+    const std::string& error() const { return err; }
+
+    // the next tick's input; false at the end of the recording
+    bool next(SimInput& out) {
+        using namespace replay_detail;
+        if (repeats > 0) { repeats--; tickCount++; out = last; return true; }
+        if (ended || pos >= data.size()) return false;
+        uint8_t flags = data[pos++];
+        if (flags == END) {
+            if (pos + 16 <= data.size()) {
+                trailerTicks = get(8);
+                trailerHash = get(8);
+                trailer = true;
+            }
+            ended = true;
+            return false;
+        }
+        if (flags == REPEAT) {
+            uint64_t n = 0;
+            for (int shift = 0; pos < data.size() && shift < 64; shift += 7) {
+                uint8_t b = data[pos++];
+                n |= (uint64_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) break;
+            }
+            if (n == 0) return next(out);
+            repeats = n - 1;
+            tickCount++;
+            out = last;
+            return true;
+        }
+        SimInput in;
+        in.up = flags & 1; in.down = flags & 2; in.left = flags & 4; in.right = flags & 8;
+        in.shoot = flags & 0x10;
+        in.aim = last.aim;
+        if (flags & AIM) {
+            if (pos + 8 > data.size()) return truncated();
+            in.aim.x = bits_float((uint32_t)get(4));
+            in.aim.y = bits_float((uint32_t)get(4));
+        }
+        if (flags & WEAPON) {
+            if (pos >= data.size()) return truncated();
+            in.weapon = data[pos++];
+        }
+        last = in;
+        tickCount++;
+        out = in;
+        return true;
+    }
+
+    uint64_t ticks_read() const { return tickCount; }
+    // after next() returned false: whether the file had its trailer, and
+    // the tick count and final hash it recorded
+    bool has_trailer() const { return trailer; }
+    uint64_t recorded_ticks() const { return trailerTicks; }
+    uint64_t recorded_hash() const { return trailerHash; }
+
+private:
+    std::vector<uint8_t> data;
+    size_t pos{ 0 };
+    ReplayHeader hdr;
+    std::string err;
+    SimInput last;
+    uint64_t repeats{ 0 };
+    uint64_t tickCount{ 0 };
+    bool ended{ false };
+    bool trailer{ false };
+    uint64_t trailerTicks{ 0 }, trailerHash{ 0 };
+
+    bool fail(const std::string& e) { err = e; return false; }
+    bool truncated() { ended = true; return false; }
+
+    uint64_t get(int bytes) {
+        uint64_t v = 0;
+        for (int i = 0; i < bytes && pos < data.size(); i++) v |= (uint64_t)data[pos++] << (8 * i);
+        return v;
+    }
+};
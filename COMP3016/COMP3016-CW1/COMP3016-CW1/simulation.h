@@ -0,0 +1,662 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "collision_grid.h"
+#include "components.h"
+#include "crowd.h"
+#include "determinism.h"
+#include "ecs.h"
+#include "flow_field.h"
+#include "input.h"
+#include "job_system.h"
+#include "player.h"
+#include "spatial_grid.h"
+#include "wave_config.h"
+#include "zombie_kernels.h"
+
+// The game simulation (waves + weapons), with no SDL: entities, systems,
+// waves, collision and the job system. Input comes in as a SimInput per
+// tick; the SDL frontend (game.h) draws what it exposes, and anything else
+// (benchmarks, the headless runner, tools) can step it directly.
+class Simulation {
+public:
+    // dc.enabled: seeded rng, precise kernels and a pinned FP environment,
+    // and the state is hashed after every tick (see determinism.h). The
+    // caller must then pass dc.tick as dt (fixed_tick()). threads: see
+    // set_worker_threads(); tools running many simulations side by side
+    // pass 1.
+    Simulation(int w, int h, const DeterminismConfig& dc = {}, int threads = 0)
+        : width(w), height(h), det(dc),
+        rnd(dc.enabled ? dc.seed : std::random_device{}()),
+        distX(20.f, w - 20.f), distY(20.f, h - 20.f)
+    {
+        if (det.enabled) {
+            enter_deterministic_fp();
+            preciseKernels = true;
+            if (!det.hashLog.empty()) hashLog = std::fopen(det.hashLog.c_str(), "w");
+        }
+        players().add(Transform{ Vec2{ w * 0.5f, h * 0.5f } }, Velocity{}, Collider{ Player::RADIUS }, Sprite{}, Health{ 3 });
+        bulletGrid.reset((float)w, (float)h, GRID_CELL);
+        zombieGrid.reset((float)w, (float)h, GRID_CELL);
+
+        cfg = load_wave_config("data/waves.txt");
+        baseSpawnInterval = cfg.spawnIntervalSec;
+        baseZombieSpeed = cfg.zombieSpeed;
+        crowdGrid.reset((float)w, (float)h, cfg.crowd.radius);
+        flow.reset((float)w, (float)h, FLOW_CELL);
+
+        set_worker_threads(threads);
+
+        load_map_geometry("data/obstacles.txt");
+        player.setup_weapons();
+
+        // firing and expiry never allocate; the pool is sized for the worst case
+        bullets().set_capacity(player.max_live_bullets());
+        bullets().set_swap_remove(true);
+
+        // zombies get stable handles; removal is O(1) and keeps rows dense
+        zombies().set_handles(true);
+        zombies().set_swap_remove(true);
+
+        build_systems();
+        start_wave(1);
+    }
+
+    ~Simulation() {
+        if (hashLog) std::fclose(hashLog);
+    }
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // one tick
+    void step(float dt, const SimInput& in) {
+        if (!running) return;
+
+        damageCooldown = std::max(0.f, damageCooldown - dt);
+
+        if (inIntermission) {
+            intermissionTimer -= dt;
+            if (intermissionTimer <= 0.f) start_wave(currentWave + 1);
+        }
+
+        if (in.weapon >= 0) player.set_weapon(in.weapon);
+        PlayerArch& pl = players();
+        pl.get<Velocity>(0).vel = player.update_input(dt, in, player_pos());
+        pl.get<Sprite>(0).faceDir = player.aim();
+
+        if (in.shoot) (void)player.try_shoot(player_pos(), bullets(), rnd);
+
+        if (stressZombies > 0) fire_stress_ring();
+
+        spawnTimer -= dt;
+        if (stressZombies == 0 && !inIntermission && pendingToSpawn > 0 && spawnTimer <= 0.f) {
+            if (alive_zombies() < simultaneousCap) {
+                spawn_zombie(); pendingToSpawn--; spawnedThisWave++;
+                spawnTimer = spawnInterval;
+            }
+            else spawnTimer = 0.15f;
+        }
+
+        // entities are only created above and destroyed below, the systems
+        // themselves just read and write columns
+        run_systems(dt);
+
+        if (stressZombies > 0) {
+            while (alive_zombies() < stressZombies) spawn_zombie();
+        }
+        else if (!inIntermission &&
+            spawnedThisWave >= totalThisWave &&
+            killedThisWave >= totalThisWave &&
+            alive_zombies() == 0)
+        {
+            inIntermission = true; intermissionTimer = cfg.curve.intermissionSec;
+        }
+
+        surviveTime += dt;
+
+        tickCount++;
+        if (det.enabled) {
+            lastHash = state_hash();
+            if (hashLog) std::fprintf(hashLog, "%" PRIu64 " %016" PRIx64 "\n", tickCount, lastHash);
+        }
+    }
+
+    // fixed dt in deterministic mode, 0 when free-running
+    float fixed_tick() const { return det.enabled ? det.tick : 0.f; }
+    uint64_t tick() const { return tickCount; }
+    // hash after the last tick (deterministic mode only)
+    uint64_t last_hash() const { return lastHash; }
+
+    // every entity column plus the game state the next tick depends on;
+    // the rng is left out, any divergence there shows up in what it spawns
+    uint64_t state_hash() const {
+        StateHash h;
+        world.visit([&](const auto& a) {
+            h.add_array(a.alive.data(), a.size());
+            a.visit_columns([&](const auto* col, int n) { h.add_array(col, n); });
+        });
+        player.hash_into(h);
+        h.add(running); h.add(surviveTime); h.add(score); h.add(damageCooldown);
+        h.add(currentWave); h.add(totalThisWave); h.add(spawnedThisWave); h.add(killedThisWave);
+        h.add(simultaneousCap); h.add(pendingToSpawn); h.add(zombieSpeed); h.add(spawnInterval);
+        h.add(spawnTimer); h.add(inIntermission); h.add(intermissionTimer);
+        h.add(aiTick); h.add(stressZombies); h.add(stressBullets);
+        return h.value();
+    }
+
+    // one pass of the systems plus dead-row removal, without input, spawning
+    // or waves (step() calls this; benchmarks can call it directly)
+    void run_systems(float dt) {
+        systems.run(dt, zombies().size() >= PARALLEL_SYSTEMS_MIN ? jobs.get() : nullptr);
+        world.remove_dead();
+    }
+
+    // threads of the job system, counting the main thread; 0 = one per
+    // hardware thread. Simulation results don't depend on it.
+    void set_worker_threads(int n) {
+        jobs.reset();
+        jobs = std::make_unique<JobSystem>(n, det.enabled ? JobSystem::Fn(enter_deterministic_fp) : JobSystem::Fn{});
+    }
+    int worker_threads() const { return jobs->thread_count(); }
+
+    // shared with anything else that wants to run work off the main thread
+    JobSystem& job_system() { return *jobs; }
+
+    // replaces the tuning loaded from data/waves.txt and restarts wave 1;
+    // call before the first step()
+    void set_wave_config(const WaveConfig& c) {
+        cfg = c;
+        baseSpawnInterval = cfg.spawnIntervalSec;
+        baseZombieSpeed = cfg.zombieSpeed;
+        crowdGrid.reset((float)width, (float)height, cfg.crowd.radius);
+        start_wave(1);
+    }
+    const WaveConfig& wave_config() const { return cfg; }
+
+    // zombie AI level of detail (ai_lod.h), loaded from data/waves.txt
+    void set_ai_lod(const AiLodConfig& c) { cfg.lod = c; }
+    const AiLodConfig& ai_lod() const { return cfg.lod; }
+    // tier counts and re-steers of the last zombie_ai pass
+    const AiLodStats& ai_lod_stats() const { return lodStats; }
+
+    // benchmarks/tools: replace the live entities with a fixed scene, zombies
+    // scattered over the arena and bullets fanned out around the player
+    void load_scene(int zombieCount, int bulletCount, unsigned seed = 1) {
+        ZombieArch& zs = zombies();
+        zs.clear();
+        bullets().clear();
+        rnd.seed(seed);
+        pendingToSpawn = 0;
+        for (int i = 0; i < zombieCount; i++) {
+            Vec2 p{ distX(rnd), distY(rnd) };
+            int z = spawn_zombie_at(zs, p, zombieSpeed);
+            if (z < 0) break;
+            steer_zombie(zs, z, (player_pos() - p).normalized());
+        }
+        std::uniform_real_distribution<float> ang(0.f, 2.f * PI);
+        std::uniform_real_distribution<float> dist(20.f, 400.f);
+        if (bulletCount > bullets().capacity()) bullets().set_capacity(bulletCount);
+        for (int i = 0; i < bulletCount; i++) {
+            float a = ang(rnd);
+            Vec2 dir{ std::cos(a), std::sin(a) };
+            spawn_bullet(bullets(), player_pos() + dir * dist(rnd), dir * 620.f, 0.9f, 4.f);
+        }
+    }
+
+    // Stress mode: replaces the waves with a horde of `zombies` (1k..100k),
+    // topped back up to that count every tick, a ring of `bulletsPerTick`
+    // bullets fired from the player every tick, and a player that can't
+    // die. Returns the horde size. See stress_test.h for the harness.
+    int start_stress(int zombies, int bulletsPerTick, unsigned seed = 1) {
+        stressZombies = std::clamp(zombies, 1000, 100000);
+        stressBullets = std::max(0, bulletsPerTick);
+        // a ring lives ~0.9 s, so at most ~60 rings in flight at 60 ticks/s
+        bullets().set_capacity(std::max(bullets().capacity(), player.max_live_bullets() + stressBullets * 64));
+        load_scene(stressZombies, 0, seed);
+        inIntermission = false;
+        return stressZombies;
+    }
+    bool stress_mode() const { return stressZombies > 0; }
+
+    int zombie_count() const { return alive_zombies(); }
+    int bullet_count() const { return bullets().size(); }
+    int score_value() const { return score; }
+    int kill_count() const { return score / KILL_SCORE; }
+
+    // per-system timings (Schedule::set_profiling)
+    Schedule& schedule() { return systems; }
+
+    // read-only views for drawing and tools
+    int arena_width() const { return width; }
+    int arena_height() const { return height; }
+    const ZombieArch& zombie_rows() const { return zombies(); }
+    const BulletArch& bullet_rows() const { return bullets(); }
+    const Player& player_state() const { return player; }
+    Vec2 player_position() const { return player_pos(); }
+    int player_hp() const { return players().get<Health>(0).hp; }
+    const std::vector<Obstacle>& obstacle_list() const { return obstacles; }
+    bool game_over() const { return !running; }
+    float survive_time() const { return surviveTime; }
+    int wave() const { return currentWave; }
+    bool in_intermission() const { return inIntermission; }
+    // killed / total of the current wave, 0..1
+    float wave_progress() const {
+        return totalThisWave > 0 ? std::clamp((float)killedThisWave / (float)totalThisWave, 0.f, 1.f) : 0.f;
+    }
+
+private:
+    int width{}, height{};
+
+    // entities (components.h), updated by the systems in build_systems()
+    GameWorld world;
+    Schedule systems;
+    Player player;                  // weapons/aim of the player entity
+
+    // job system (job_system.h): systems sharing a stage, and the
+    // data-parallel loops inside them. Chunk sizes are multiples of 8 so the
+    // steering kernel groups lanes exactly as in one serial call.
+    std::unique_ptr<JobSystem> jobs;
+    // below this many zombies running systems side by side costs more than it saves
+    static constexpr int PARALLEL_SYSTEMS_MIN = 4000;
+    static constexpr int ZOMBIE_CHUNK = 1024;
+    static constexpr int BULLET_CHUNK = 2048;
+
+    // shared state the systems touch besides components, for Access sets
+    enum Resource { RES_FLOW, RES_CROWD_GRID, RES_STEER, RES_BULLET_GRID, RES_ZOMBIE_GRID, RES_STATE };
+
+    // broadphase, cells sized to the largest collider (player/zombie r = 14)
+    static constexpr float GRID_CELL = 28.f;
+    static constexpr float MAX_ZOMBIE_RADIUS = 14.f;
+    static constexpr float MAX_BULLET_RADIUS = 4.f;
+
+    // the arena is the window inset by ARENA_INSET (clamp_to_arena); edge
+    // spawns start at SPAWN_INSET, just outside it
+    static constexpr float ARENA_INSET = 20.f;
+    static constexpr float SPAWN_INSET = 18.f;
+    // past this far outside the arena a bullet can't reach any zombie
+    static constexpr float BULLET_CULL_MARGIN = (ARENA_INSET - SPAWN_INSET) + MAX_ZOMBIE_RADIUS + MAX_BULLET_RADIUS;
+    SpatialGrid bulletGrid;
+    SpatialGrid zombieGrid;
+
+    // swept bullet hits: one sorted run of candidate pairs per zombie chunk,
+    // merged into hitRuns[0]; reused every tick
+    struct HitPair { float toi; int bullet, zombie; };
+    static bool hit_before(const HitPair& a, const HitPair& b) {
+        if (a.toi != b.toi) return a.toi < b.toi;
+        return a.bullet != b.bullet ? a.bullet < b.bullet : a.zombie < b.zombie;
+    }
+    std::vector<std::vector<HitPair>> hitRuns, hitScratch;
+    std::vector<unsigned char> bulletSpent, zombieHitThisTick;
+
+    // crowd steering
+    SpatialGrid crowdGrid;
+
+    // steering kernel (zombie_kernels.h)
+    SimdLevel simd{ detect_simd() };
+    bool preciseKernels{ false };   // bit-identical to the scalar path when set
+    std::vector<float> steerX, steerY;
+
+    // AI level of detail: ticks of zombie_ai so far (the stagger clock),
+    // last pass's counts, and the per-chunk counts they're summed from
+    uint64_t aiTick{ 0 };
+    AiLodStats lodStats;
+    std::vector<AiLodStats> lodChunks;
+
+    // pathfinding toward the player
+    static constexpr float FLOW_CELL = 24.f;
+    FlowField flow;
+
+    // static map geometry
+    static constexpr float COLLISION_CELL = 8.f;
+    std::vector<Obstacle> obstacles;
+    CollisionGrid collision;
+
+    // deterministic mode
+    DeterminismConfig det;
+    uint64_t tickCount{ 0 };
+    uint64_t lastHash{ 0 };
+    std::FILE* hashLog{};
+
+    // state
+    static constexpr int KILL_SCORE = 10;
+    bool  running{ true };
+    float surviveTime{ 0.f };
+    int   score{ 0 };
+
+    // base tuning
+    WaveConfig cfg{};
+    float baseZombieSpeed{ 90.f };
+    float baseSpawnInterval{ 1.0f };
+
+    // waves
+    int   currentWave{ 1 };
+    int   totalThisWave{ 0 };
+    int   spawnedThisWave{ 0 };
+    int   killedThisWave{ 0 };
+    int   simultaneousCap{ 6 };
+    int   pendingToSpawn{ 0 };
+    float zombieSpeed{ 90.f };
+    float spawnInterval{ 1.0f };
+    float spawnTimer{ 0.f };
+    bool  inIntermission{ false };
+    float intermissionTimer{ 0.f };
+
+    // stress mode (start_stress), 0 = off
+    int stressZombies{ 0 };
+    int stressBullets{ 0 };
+
+    // rng
+    std::mt19937 rnd;
+    std::uniform_real_distribution<float> distX;
+    std::uniform_real_distribution<float> distY;
+
+    // player hit cooldown
+    float damageCooldown{ 0.f };
+
+    // helpers
+    PlayerArch& players() { return world.get<PlayerArch>(); }
+    const PlayerArch& players() const { return world.get<PlayerArch>(); }
+    ZombieArch& zombies() { return world.get<ZombieArch>(); }
+    const ZombieArch& zombies() const { return world.get<ZombieArch>(); }
+    BulletArch& bullets() { return world.get<BulletArch>(); }
+    const BulletArch& bullets() const { return world.get<BulletArch>(); }
+    Vec2& player_pos() { return players().get<Transform>(0).pos; }
+    const Vec2& player_pos() const { return players().get<Transform>(0).pos; }
+
+    // dead rows are removed at the end of every update(), so outside the
+    // systems the dense row count is the live count
+    int alive_zombies() const { return zombies().size(); }
+
+    void clamp_to_arena(Vec2& p) const {
+        float minX = ARENA_INSET, minY = ARENA_INSET, maxX = (float)width - ARENA_INSET, maxY = (float)height - ARENA_INSET;
+        p.x = std::clamp(p.x, minX, maxX);
+        p.y = std::clamp(p.y, minY, maxY);
+    }
+
+    void load_map_geometry(const std::string& path) {
+        obstacles = load_obstacles(path);
+        collision.reset((float)width, (float)height, COLLISION_CELL);
+        for (const Obstacle& o : obstacles) collision.add_rect(o.x, o.y, o.w, o.h);
+
+        // a flow cell is closed if any of it is solid
+        const float fc = flow.cell_size();
+        for (int cy = 0; cy < flow.row_count(); cy++)
+            for (int cx = 0; cx < flow.columns(); cx++)
+                if (collision.box_blocked(cx * fc, cy * fc, (cx + 1) * fc - 0.01f, (cy + 1) * fc - 0.01f))
+                    flow.set_blocked(cx, cy, true);
+    }
+
+    // stress mode: evenly spaced bullets, the ring turned a little each tick
+    void fire_stress_ring() {
+        const float turn = (float)(tickCount % 1000) * 0.61803f;
+        for (int k = 0; k < stressBullets; k++) {
+            float a = turn + 2.f * PI * (float)k / (float)stressBullets;
+            Vec2 dir{ std::cos(a), std::sin(a) };
+            if (spawn_bullet(bullets(), player_pos(), dir * 620.f, 0.9f, 4.f) < 0) break;
+        }
+    }
+
+    void spawn_zombie() 
+    {
+        int side = std::uniform_int_distribution<int>(0, 3)(rnd);
+        float x = 0, y = 0;
+        if (side == 0) { x = distX(rnd); y = SPAWN_INSET; }
+        if (side == 1) { x = distX(rnd); y = height - SPAWN_INSET; }
+        if (side == 2) { x = SPAWN_INSET; y = distY(rnd); }
+        if (side == 3) { x = width - SPAWN_INSET; y = distY(rnd); }
+        spawn_zombie_at(zombies(), Vec2{ x,y }, zombieSpeed);
+    }
+
+    // One system per update phase. Access sets are per archetype column, so
+    // e.g. bullet movement shares a stage with player movement; see
+    // Schedule for how stages are formed.
+    void build_systems() {
+        using W = GameWorld;
+        {
+            Access a;
+            a.reads = W::cols<PlayerArch, Velocity, Collider>();
+            a.writes = W::cols<PlayerArch, Transform>();
+            systems.add("player_move", a, [this](float dt) {
+                PlayerArch& pl = players();
+                Vec2& p = pl.get<Transform>(0).pos;
+                p = collision.move_circle(p, pl.get<Velocity>(0).vel * dt, pl.get<Collider>(0).radius);
+                clamp_to_arena(p);
+            });
+        }
+        {
+            Access a;
+            a.reads = W::cols<BulletArch, Velocity>();
+            a.writes = W::cols<BulletArch, Transform, Lifetime, Sweep, Alive>();
+            systems.add("bullets", a, [this](float dt) {
+                BulletArch& bs = bullets();
+                Transform* tf = bs.data<Transform>();
+                const Velocity* vel = bs.data<Velocity>();
+                Lifetime* life = bs.data<Lifetime>();
+                Sweep* sweep = bs.data<Sweep>();
+                // the arena rect grown by the reach of anything a bullet can hit
+                const float minX = ARENA_INSET - BULLET_CULL_MARGIN, minY = ARENA_INSET - BULLET_CULL_MARGIN;
+                const float maxX = (float)width - ARENA_INSET + BULLET_CULL_MARGIN;
+                const float maxY = (float)height - ARENA_INSET + BULLET_CULL_MARGIN;
+                jobs->parallel_for(bs.size(), BULLET_CHUNK, [&](int b, int e) {
+                    for (int i = b; i < e; i++) {
+                        life[i].age += dt;
+                        if (life[i].age >= life[i].life) bs.alive[i] = 0;
+                        Vec2 from = tf[i].pos;
+                        Vec2 to = from + vel[i].vel * dt;
+                        sweep[i].from = from;
+                        if (collision.segment_hit(from, to, &to)) bs.alive[i] = 0;
+                        // out of reach of the arena, don't wait for lifetime
+                        if (to.x < minX || to.y < minY || to.x > maxX || to.y > maxY) bs.alive[i] = 0;
+                        tf[i].pos = to;
+                    }
+                });
+            });
+        }
+        {
+            Access a;
+            a.reads = W::cols<PlayerArch, Transform>() | W::cols<ZombieArch, Collider, AI>();
+            a.writes = W::cols<ZombieArch, Transform, Velocity, Sprite, Sweep>()
+                | Access::res(RES_FLOW) | Access::res(RES_CROWD_GRID) | Access::res(RES_STEER);
+            systems.add("zombie_ai", a, [this](float dt) { update_zombie_ai(dt); });
+        }
+        {
+            // Swept: each bullet and zombie moved in a straight line this tick
+            // (Sweep::from -> Transform::pos), so fast bullets can't skip
+            // past a zombie between ticks. Bullets are bucketed by the middle
+            // of their segment; each zombie tests the bullets around its own.
+            // Pairs resolve in order of time of impact, ties by bullet then
+            // zombie row, and each bullet/zombie takes part in one hit per tick.
+            // Bullets that hit a wall, left the arena or expired this tick
+            // still travelled their (clipped) segment, so they can hit too.
+            // The narrowphase runs in zombie chunks on the job system, each
+            // chunk emitting and sorting its own candidate pairs; the sorted
+            // runs are merged and resolved in that one total order, so kills
+            // and score don't depend on the thread count.
+            Access a;
+            a.reads = W::cols<ZombieArch, Transform, Collider, Sweep>() | W::cols<BulletArch, Transform, Collider, Sweep>();
+            a.writes = W::cols<ZombieArch, Health, Alive>() | W::cols<BulletArch, Alive>()
+                | Access::res(RES_BULLET_GRID) | Access::res(RES_STATE);
+            systems.add("bullet_hits", a, [this](float) {
+                ZombieArch& zs = zombies();
+                BulletArch& bs = bullets();
+                const Transform* btf = bs.data<Transform>();
+                const Collider* bcol = bs.data<Collider>();
+                const Sweep* bsw = bs.data<Sweep>();
+                float bulletHalf = 0.f;
+                for (int i = 0; i < bs.size(); i++) bulletHalf = std::max(bulletHalf, (btf[i].pos - bsw[i].from).len() * 0.5f);
+                bulletGrid.build(bs.size(), [&](int i) { return (bsw[i].from + btf[i].pos) * 0.5f; }, *jobs);
+
+                const int nz = zs.size();
+                const int chunks = (nz + ZOMBIE_CHUNK - 1) / ZOMBIE_CHUNK;
+                if (chunks == 0) return;
+                hitRuns.resize(std::max<size_t>(hitRuns.size(), (size_t)chunks));
+                hitScratch.resize(hitRuns.size());
+                jobs->parallel_for(nz, ZOMBIE_CHUNK, [&](int b, int e) {
+                    std::vector<HitPair>& out = hitRuns[b / ZOMBIE_CHUNK];
+                    out.clear();
+                    for (int zi = b; zi < e; zi++) {
+                        if (!zs.alive[zi]) continue;
+                        Vec2 z0 = zs.get<Sweep>(zi).from, z1 = zs.get<Transform>(zi).pos;
+                        float zr = zs.get<Collider>(zi).radius;
+                        float reach = zr + MAX_BULLET_RADIUS + bulletHalf + (z1 - z0).len() * 0.5f;
+                        bulletGrid.query_radius((z0 + z1) * 0.5f, reach, [&](int i) {
+                            float toi;
+                            if (swept_circle_hit(z0, z1, zr, bsw[i].from, btf[i].pos, bcol[i].radius, &toi))
+                                out.push_back(HitPair{ toi, i, zi });
+                        });
+                    }
+                    std::sort(out.begin(), out.end(), hit_before);
+                });
+
+                // merge rounds: after the one with `width`, run j*2*width holds
+                // runs j*2*width .. (j+1)*2*width-1, so run 0 ends up with all
+                for (int width = 1; width < chunks; width *= 2) {
+                    jobs->parallel_for((chunks + 2 * width - 1) / (2 * width), 1, [&](int b, int) {
+                        int lo = b * 2 * width, hi = lo + width;
+                        if (hi >= chunks) return;
+                        std::vector<HitPair>& dst = hitScratch[lo];
+                        dst.resize(hitRuns[lo].size() + hitRuns[hi].size());
+                        std::merge(hitRuns[lo].begin(), hitRuns[lo].end(), hitRuns[hi].begin(), hitRuns[hi].end(), dst.begin(), hit_before);
+                        std::swap(hitRuns[lo], dst);
+                        hitRuns[hi].clear();
+                    });
+                }
+
+                bulletSpent.assign((size_t)bs.size(), 0);
+                zombieHitThisTick.assign((size_t)nz, 0);
+                for (const HitPair& h : hitRuns[0]) {
+                    if (bulletSpent[h.bullet] || zombieHitThisTick[h.zombie]) continue;
+                    bulletSpent[h.bullet] = 1;
+                    bs.alive[h.bullet] = 0;
+                    zombieHitThisTick[h.zombie] = 1;
+                    if (--zs.get<Health>(h.zombie).hp <= 0) { zs.alive[h.zombie] = 0; score += KILL_SCORE; killedThisWave++; }
+                }
+            });
+        }
+        {
+            Access a;
+            a.reads = W::cols<PlayerArch, Transform, Collider>() | W::cols<ZombieArch, Collider, Alive>();
+            a.writes = W::cols<ZombieArch, Transform>() | W::cols<PlayerArch, Health>()
+                | Access::res(RES_ZOMBIE_GRID) | Access::res(RES_STATE);
+            systems.add("player_contact", a, [this](float) {
+                ZombieArch& zs = zombies();
+                Transform* tf = zs.data<Transform>();
+                const Vec2 pp = player_pos();
+                const float pr = players().get<Collider>(0).radius;
+                Health& hp = players().get<Health>(0);
+                zombieGrid.build(zs.size(), [&](int i) { return tf[i].pos; }, *jobs);
+                zombieGrid.query_radius(pp, pr + MAX_ZOMBIE_RADIUS, [&](int i) {
+                    Vec2 zp = tf[i].pos;
+                    float zr = zs.get<Collider>(i).radius;
+                    if (zs.alive[i] && circle_hit(zp, zr, pp, pr)) {
+                        if (damageCooldown <= 0.f && stressZombies == 0) {
+                            hp.hp -= 1;
+                            damageCooldown = 0.6f; // 600 ms i-frames
+                            if (hp.hp <= 0) running = false;
+                        }
+                        Vec2 away = (zp - pp).normalized();
+                        tf[i].pos = collision.move_circle(zp, away * 6.f, zr);
+                    }
+                });
+            });
+        }
+    }
+
+    // Time-sliced: the steering decision (flow field + crowd) runs only for
+    // the zombies whose bucket is due this tick (ai_lod.h); the rest feed
+    // their cached velocity back in as the wanted direction, which the kernel
+    // turns back into the same heading before integrating. Steering only
+    // writes vel, so every zombie sees the same positions.
+    void update_zombie_ai(float dt) {
+        ZombieArch& zs = zombies();
+        const int nz = zs.size();
+        const Vec2 target = player_pos();
+        const uint64_t tick = aiTick++;
+        const int minInterval = ai_budget_interval(nz, cfg.lod);
+        flow.update(target);
+        lodStats = AiLodStats{};
+        if (nz == 0) return;
+
+        Transform* tf = zs.data<Transform>();
+        Sweep* sweep = zs.data<Sweep>();
+        const Velocity* vel = zs.data<Velocity>();
+        crowdGrid.build(nz, [&](int i) { return tf[i].pos; }, *jobs);
+        steerX.resize(nz);
+        steerY.resize(nz);
+        lodChunks.assign((size_t)(nz + ZOMBIE_CHUNK - 1) / ZOMBIE_CHUNK, AiLodStats{});
+        jobs->parallel_for(nz, ZOMBIE_CHUNK, [&](int b, int e) {
+            AiLodStats& st = lodChunks[b / ZOMBIE_CHUNK];
+            for (int i = b; i < e; i++) {
+                Vec2 p = tf[i].pos;
+                sweep[i].from = p;
+                Vec2 d = target - p;
+                AiTier t = ai_tier(d.x * d.x + d.y * d.y, cfg.lod);
+                st.tier[t]++;
+                Vec2 v = vel[i].vel;
+                Vec2 want = v;
+                // nothing to dead-reckon on yet (just spawned)
+                if (ai_due(t, zs.handle(i).slot(), tick, cfg.lod, minInterval) || (v.x == 0.f && v.y == 0.f)) {
+                    st.steered[t]++;
+                    want = flow.direction(p, target);
+                    if (t != AI_FAR) want += crowd_force(i, p, crowdGrid, [&](int j) { return tf[j].pos; }, cfg.crowd);
+                }
+                steerX[i] = want.x; steerY[i] = want.y;
+            }
+        });
+        for (const AiLodStats& c : lodChunks) lodStats.add(c);
+
+        // normalize/scale/face in one vectorized pass; on an open map it also
+        // integrates and clamps, otherwise movement goes through the grid
+        ZombieKernelArgs k;
+        k.pos = &tf->pos;
+        k.vel = &zs.data<Velocity>()->vel;
+        k.speed = &zs.data<AI>()->speed;
+        k.dirX = steerX.data(); k.dirY = steerY.data();
+        k.face = &zs.data<Sprite>()->faceDir;
+        k.n = nz;
+        k.integrate = collision.empty();
+        k.dt = dt;
+        k.minX = ARENA_INSET; k.minY = ARENA_INSET; k.maxX = (float)width - ARENA_INSET; k.maxY = (float)height - ARENA_INSET;
+        jobs->parallel_for(nz, ZOMBIE_CHUNK, [&](int b, int e) {
+            ZombieKernelArgs c = k;
+            c.pos += b; c.vel += b; c.speed += b; c.dirX += b; c.dirY += b; c.face += b;
+            c.n = e - b;
+            zombie_kernel(c, simd, preciseKernels);
+        });
+        if (!k.integrate) {
+            const Collider* col = zs.data<Collider>();
+            jobs->parallel_for(nz, ZOMBIE_CHUNK, [&](int b, int e) {
+                for (int i = b; i < e; i++) {
+                    Vec2 p = collision.move_circle(tf[i].pos, vel[i].vel * dt, col[i].radius);
+                    clamp_to_arena(p);
+                    tf[i].pos = p;
+                }
+            });
+        }
+    }
+
+
+    void start_wave(int wave) {
+        currentWave = wave;
+        const WaveCurve& c = cfg.curve;
+        totalThisWave = c.firstCount + (wave - 1) * c.countStep;
+        simultaneousCap = std::min(c.firstCap + (wave - 1) * c.capStep, c.maxCap);
+        spawnInterval = std::max(c.minSpawnInterval, baseSpawnInterval * std::pow(c.spawnDecay, float(wave - 1)));
+        zombieSpeed = baseZombieSpeed * (1.0f + c.speedStep * float(wave - 1));
+
+        spawnedThisWave = 0;
+        killedThisWave = 0;
+        pendingToSpawn = totalThisWave;
+        spawnTimer = 0.25f;
+        inIntermission = false;
+    }
+};
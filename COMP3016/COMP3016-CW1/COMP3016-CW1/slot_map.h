@@ -0,0 +1,96 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// 32-bit generational handle: low 20 bits slot, high 12 bits generation.
+// A slot's generation is bumped when its entity is removed, so handles to
+// the old entity stop resolving instead of pointing at whatever reuses the
+// slot. 0 is never issued (generations start at 1) and acts as null.
+struct Handle {
+    uint32_t id{ 0 };
+
+    static constexpr int SLOT_BITS = 20;
+    static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+    static constexpr uint32_t GEN_MASK = (1u << (32 - SLOT_BITS)) - 1;
+
+    uint32_t slot() const { return id & SLOT_MASK; }
+    uint32_t generation() const { return id >> SLOT_BITS; }
+    explicit operator bool() const { return id != 0; }
+    bool operator==(const Handle& o) const { return id == o.id; }
+    bool operator!=(const Handle& o) const { return id != o.id; }
+};
+
+// Generational slot map over a dense array owned by someone else (an
+// archetype's columns): maps handles to dense rows and rows back to
+// handles. insert/remove/lookup are O(1); the owner keeps its data dense by
+// moving the last row into a removed one and telling the map (moved()).
+class SlotMap {
+public:
+    int count() const { return (int)rowSlot.size(); }
+
+    // slots a handle can address; past this the slot index would spill
+    // into the generation bits
+    static constexpr uint32_t MAX_SLOTS = Handle::SLOT_MASK + 1;
+
+    // new handle for row count(), the row the owner is about to append;
+    // null (nothing changed) when all MAX_SLOTS slots are live
+    Handle insert() {
+        uint32_t s;
+        if (freeHead != NONE) { s = freeHead; freeHead = slots[s].row; }
+        else if (slots.size() >= MAX_SLOTS) return Handle{};
+        else { s = (uint32_t)slots.size(); slots.push_back({ 0, 1 }); }
+        slots[s].row = (uint32_t)rowSlot.size();
+        rowSlot.push_back(s);
+        return make(s);
+    }
+
+    // -1 if h is null, stale or out of range
+    int row(Handle h) const {
+        uint32_t s = h.slot();
+        if (!h || s >= slots.size() || slots[s].gen != h.generation()) return -1;
+        return (int)slots[s].row;
+    }
+
+    Handle handle(int row) const { return make(rowSlot[row]); }
+
+    // row `from` now lives at row `to` (the owner moved it)
+    void moved(int from, int to) {
+        uint32_t s = rowSlot[from];
+        rowSlot[to] = s;
+        slots[s].row = (uint32_t)to;
+    }
+
+    // forget the entity at `row`; its handle goes stale
+    void release(int row) {
+        uint32_t s = rowSlot[row];
+        slots[s].gen = (slots[s].gen + 1) & Handle::GEN_MASK;
+        if (slots[s].gen == 0) slots[s].gen = 1;
+        slots[s].row = freeHead;
+        freeHead = s;
+    }
+
+    // drop rows >= n, after the owner compacted (every dropped row must
+    // have been released or moved)
+    void truncate(int n) { rowSlot.resize(n); }
+
+    void clear() {
+        for (int r = 0; r < count(); r++) release(r);
+        rowSlot.clear();
+    }
+
+    void reserve(int n) { rowSlot.reserve(n); slots.reserve(n); }
+
+private:
+    static constexpr uint32_t NONE = 0xffffffffu;
+
+    struct Slot {
+        uint32_t row;   // dense row, or next free slot
+        uint32_t gen;
+    };
+    std::vector<Slot> slots;
+    std::vector<uint32_t> rowSlot;      // dense row -> slot
+    uint32_t freeHead{ NONE };
+
+    Handle make(uint32_t s) const { return Handle{ (slots[s].gen << Handle::SLOT_BITS) | s }; }
+};
@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "memory_stats.h"
+
+// Soak test bookkeeping (--soak on the game and the headless runner): the
+// bot plays back-to-back games for hours while this records frame times
+// and writes one CSV row per interval: mean, p99 and worst frame ms,
+// resident memory, live textures (-1 headless), games started and the
+// horde size. finish() compares the last interval with the first, so a
+// leak or a slow drift shows up as growth, and returns non-zero if the
+// texture count moved.
+struct SoakConfig {
+    double minutes{ 0.0 };          // 0 = off
+    double intervalSec{ 60.0 };     // seconds per report row
+};
+
+class SoakMonitor {
+public:
+    SoakMonitor(const SoakConfig& c, std::FILE* o) : cfg(c), out(o), start(clock::now()), intervalStart(start) {
+        std::fprintf(out, "minute,frames,frame_ms_mean,frame_ms_p99,frame_ms_max,rss_mb,textures,games,zombies\n");
+    }
+
+    // one frame (or tick) that took ms
+    void frame(double ms) { frameMs.push_back((float)ms); }
+
+    // closes the interval if it's over; textures < 0 when there's no renderer
+    void poll(long long textures, int games, int zombies) {
+        if (seconds_since(intervalStart) < cfg.intervalSec) return;
+        close_interval(textures, games, zombies);
+    }
+
+    bool done() const { return seconds_since(start) >= cfg.minutes * 60.0; }
+
+    // last row, the drift summary (# lines); 1 if textures leaked
+    int finish(long long textures, int games, int zombies) {
+        if (!frameMs.empty() || rows.empty()) close_interval(textures, games, zombies);
+        const Row& a = rows.front();
+        const Row& b = rows.back();
+        std::fprintf(out, "# %.1f minutes, %d games\n", seconds_since(start) / 60.0, games);
+        std::fprintf(out, "# frame ms  %.3f -> %.3f (%+.1f%%), p99 %.3f -> %.3f\n",
+            a.meanMs, b.meanMs, a.meanMs > 0.0 ? (b.meanMs / a.meanMs - 1.0) * 100.0 : 0.0, a.p99Ms, b.p99Ms);
+        std::fprintf(out, "# rss MB    %.1f -> %.1f (%+.1f), peak %.1f\n",
+            a.rssMb, b.rssMb, b.rssMb - a.rssMb, peak_memory_bytes() / 1048576.0);
+        if (textures >= 0) std::fprintf(out, "# textures  %lld -> %lld\n", a.textures, b.textures);
+        std::fflush(out);
+        return a.textures != b.textures ? 1 : 0;
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Row {
+        double meanMs, p99Ms, rssMb;
+        long long textures;
+    };
+
+    SoakConfig cfg;
+    std::FILE* out;
+    clock::time_point start, intervalStart;
+    std::vector<float> frameMs;     // this interval
+    std::vector<Row> rows;
+
+    static double seconds_since(clock::time_point t) {
+        return std::chrono::duration<double>(clock::now() - t).count();
+    }
+
+    void close_interval(long long textures, int games, int zombies) {
+        Row row{ 0.0, 0.0, current_memory_bytes() / 1048576.0, textures };
+        float worst = 0.f;
+        if (!frameMs.empty()) {
+            double sum = 0.0;
+            for (float ms : frameMs) { sum += ms; worst = std::max(worst, ms); }
+            row.meanMs = sum / frameMs.size();
+            size_t k = std::min(frameMs.size() - 1, frameMs.size() * 99 / 100);
+            std::nth_element(frameMs.begin(), frameMs.begin() + k, frameMs.end());
+            row.p99Ms = frameMs[k];
+        }
+        std::fprintf(out, "%.2f,%zu,%.3f,%.3f,%.3f,%.1f,%lld,%d,%d\n", seconds_since(start) / 60.0, frameMs.size(),
+            row.meanMs, row.p99Ms, worst, row.rssMb, textures, games, zombies);
+        std::fflush(out);
+        rows.push_back(row);
+        frameMs.clear();
+        intervalStart = clock::now();
+    }
+};
@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "vec2.h"
+#include "job_system.h"
+
+// Uniform grid over the arena for broadphase queries.
+// Rebuilt every tick with a counting sort (two linear passes, no per-cell
+// allocations), so items inside a cell stay in ascending index order.
+// Positions outside the arena are clamped into the border cells.
+class SpatialGrid {
+public:
+    void reset(float worldW, float worldH, float cell) {
+        cellSize = cell;
+        invCell = 1.f / cell;
+        cols = std::max(1, (int)std::ceil(worldW * invCell));
+        rows = std::max(1, (int)std::ceil(worldH * invCell));
+        cellStart.assign((size_t)cols * rows + 1, 0);
+    }
+
+    // pos(i) -> Vec2 for i in [0, count)
+    template<typename PosFn>
+    void build(int count, PosFn pos) {
+        itemCell.resize((size_t)count);
+        items.resize((size_t)count);
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+
+        for (int i = 0; i < count; i++) {
+            Vec2 p = pos(i);
+            int c = cell_index(cell_x(p.x), cell_y(p.y));
+            itemCell[i] = c;
+            cellStart[c + 1]++;
+        }
+        for (size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+
+        cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < count; i++) items[cursor[itemCell[i]]++] = i;
+    }
+
+    // Same result as build(), split over a pool: each chunk of items counts
+    // its own cells, a prefix pass over (cell, chunk) gives every chunk its
+    // write position in each cell, then the chunks scatter in parallel.
+    // Chunks are in index order, so cells stay sorted by index.
+    template<typename PosFn>
+    void build(int count, PosFn pos, JobSystem& pool) {
+        if (count < PARALLEL_BUILD_CHUNK * 2 || pool.thread_count() == 1) { build(count, pos); return; }
+        const int cells = cols * rows;
+        const int chunks = (count + PARALLEL_BUILD_CHUNK - 1) / PARALLEL_BUILD_CHUNK;
+        itemCell.resize((size_t)count);
+        items.resize((size_t)count);
+        chunkCursor.assign((size_t)chunks * cells, 0);
+
+        pool.parallel_for(count, PARALLEL_BUILD_CHUNK, [&](int b, int e) {
+            int* counts = &chunkCursor[(size_t)(b / PARALLEL_BUILD_CHUNK) * cells];
+            for (int i = b; i < e; i++) {
+                Vec2 p = pos(i);
+                int c = cell_index(cell_x(p.x), cell_y(p.y));
+                itemCell[i] = c;
+                counts[c]++;
+            }
+        });
+        int at = 0;
+        for (int c = 0; c < cells; c++) {
+            cellStart[c] = at;
+            for (int k = 0; k < chunks; k++) {
+                int& n = chunkCursor[(size_t)k * cells + c];
+                int start = at;
+                at += n;
+                n = start;
+            }
+        }
+        cellStart[cells] = at;
+        pool.parallel_for(count, PARALLEL_BUILD_CHUNK, [&](int b, int e) {
+            int* cursorK = &chunkCursor[(size_t)(b / PARALLEL_BUILD_CHUNK) * cells];
+            for (int i = b; i < e; i++) items[cursorK[itemCell[i]]++] = i;
+        });
+    }
+
+    // fn(i) for every item whose cell overlaps the box; if fn returns bool,
+    // false stops the walk there
+    template<typename Fn>
+    void query(float minX, float minY, float maxX, float maxY, Fn fn) const {
+        int x0 = cell_x(minX), x1 = cell_x(maxX);
+        int y0 = cell_y(minY), y1 = cell_y(maxY);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int c = cell_index(cx, cy);
+                for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                    if constexpr (std::is_same_v<std::invoke_result_t<Fn&, int>, bool>) {
+                        if (!fn(items[k])) return;
+                    }
+                    else fn(items[k]);
+                }
+            }
+        }
+    }
+
+    template<typename Fn>
+    void query_radius(const Vec2& p, float reach, Fn fn) const {
+        query(p.x - reach, p.y - reach, p.x + reach, p.y + reach, fn);
+    }
+
+    float cell_size() const { return cellSize; }
+
+private:
+    static constexpr int PARALLEL_BUILD_CHUNK = 4096;
+
+    float cellSize{ 1.f }, invCell{ 1.f };
+    int cols{ 1 }, rows{ 1 };
+    std::vector<int> cellStart{ 0, 0 };  // prefix sums, cols*rows + 1
+    std::vector<int> items;              // item indices grouped by cell
+    std::vector<int> itemCell;
+    std::vector<int> cursor;
+    std::vector<int> chunkCursor;        // chunks * cells, parallel build only
+
+    int cell_x(float x) const { return std::clamp((int)std::floor(x * invCell), 0, cols - 1); }
+    int cell_y(float y) const { return std::clamp((int)std::floor(y * invCell), 0, rows - 1); }
+    int cell_index(int cx, int cy) const { return cy * cols + cx; }
+};
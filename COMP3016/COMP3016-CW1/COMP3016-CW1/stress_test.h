@@ -0,0 +1,87 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "game.h"
+#include "memory_stats.h"
+#include "render_stats.h"
+
+// Horde stress test (--stress on the command line): Simulation::start_stress()
+// with a big horde, then a fixed number of ticks at a fixed dt, each
+// followed by a draw, as fast as the machine goes. Prints one JSON object:
+// ticks/sec, ms per phase (update, every system, draw), peak memory and
+// draw calls per frame.
+struct StressConfig {
+    int zombies{ 0 };           // 0 = off, else clamped to 1k..100k
+    int ticks{ 600 };
+    int bulletsPerTick{ 16 };
+    unsigned seed{ 1 };
+};
+
+// returns the number of ticks run (fewer if the window was closed)
+inline int run_stress(Game& game, const StressConfig& cfg, std::FILE* out) {
+    using clock = std::chrono::steady_clock;
+    auto ms_between = [](clock::time_point a, clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    Simulation& sim = game.sim();
+    const int horde = sim.start_stress(cfg.zombies, cfg.bulletsPerTick, cfg.seed);
+    const float dt = sim.fixed_tick() > 0.f ? sim.fixed_tick() : 1.f / 60.f;
+    const SimInput idle;    // the ring does the shooting
+
+    Schedule& sched = sim.schedule();
+    sched.set_profiling(true);
+    sched.reset_timings();
+
+    double updateMs = 0.0, drawMs = 0.0, worstTickMs = 0.0;
+    long long drawCalls = 0, textureSwitches = 0, worstDrawCalls = 0;
+    int ticks = 0;
+    const auto start = clock::now();
+    for (; ticks < cfg.ticks; ticks++) {
+        bool quit = false;
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) quit |= e.type == SDL_EVENT_QUIT;
+        if (quit) break;
+
+        auto t0 = clock::now();
+        game.update(dt, idle);
+        auto t1 = clock::now();
+        render_stats().reset();
+        game.draw();
+        auto t2 = clock::now();
+
+        updateMs += ms_between(t0, t1);
+        drawMs += ms_between(t1, t2);
+        worstTickMs = std::max(worstTickMs, ms_between(t0, t2));
+        drawCalls += render_stats().drawCalls;
+        textureSwitches += render_stats().textureSwitches;
+        worstDrawCalls = std::max(worstDrawCalls, render_stats().drawCalls);
+    }
+    const double seconds = ms_between(start, clock::now()) / 1000.0;
+    sched.set_profiling(false);
+
+    const double n = std::max(1, ticks);
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"zombies\": %d,\n  \"bullets_per_tick\": %d,\n  \"threads\": %d,\n",
+        horde, cfg.bulletsPerTick, sim.worker_threads());
+    std::fprintf(out, "  \"ticks\": %d,\n  \"seconds\": %.3f,\n  \"ticks_per_sec\": %.2f,\n",
+        ticks, seconds, seconds > 0.0 ? ticks / seconds : 0.0);
+    std::fprintf(out, "  \"worst_tick_ms\": %.3f,\n", worstTickMs);
+    std::fprintf(out, "  \"phase_ms\": {\n    \"update\": %.3f,\n", updateMs / n);
+    for (int s = 0; s < sched.system_count(); s++)
+        std::fprintf(out, "    \"%s\": %.3f,\n", sched.name_of(s), sched.ms_of(s) / n);
+    std::fprintf(out, "    \"draw\": %.3f\n  },\n", drawMs / n);
+    std::fprintf(out, "  \"peak_memory_bytes\": %llu,\n", (unsigned long long)peak_memory_bytes());
+    std::fprintf(out, "  \"draw_calls\": { \"per_frame\": %.1f, \"worst_frame\": %lld, \"texture_switches_per_frame\": %.1f },\n",
+        drawCalls / n, worstDrawCalls, textureSwitches / n);
+    std::fprintf(out, "  \"end\": { \"zombies\": %d, \"bullets\": %d, \"score\": %d }\n",
+        sim.zombie_count(), sim.bullet_count(), sim.score_value());
+    std::fprintf(out, "}\n");
+    return ticks;
+}
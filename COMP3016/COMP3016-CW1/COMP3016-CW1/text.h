@@ -0,0 +1,61 @@
+﻿#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cctype>
+#include <string>
+
+#include "render_stats.h"
+
+struct Glyph5x7 { const char ch; const unsigned char rows[7]; };
+inline const Glyph5x7 FONT[] = {
+    { 'A',{0b01110,0b10001,0b10001,0b11111,0b10001,0b10001,0b10001} },
+    { 'E',{0b11111,0b10000,0b10000,0b11110,0b10000,0b10000,0b11111} },
+    { 'F',{0b11111,0b10000,0b10000,0b11110,0b10000,0b10000,0b10000} },
+    { 'I',{0b11111,0b00100,0b00100,0b00100,0b00100,0b00100,0b11111} },
+    { 'L',{0b10000,0b10000,0b10000,0b10000,0b10000,0b10000,0b11111} },
+    { 'N',{0b10001,0b11001,0b10101,0b10011,0b10001,0b10001,0b10001} },
+    { 'O',{0b01110,0b10001,0b10001,0b10001,0b10001,0b10001,0b01110} },
+    { 'P',{0b11110,0b10001,0b10001,0b11110,0b10000,0b10000,0b10000} },
+    { 'R',{0b11110,0b10001,0b10001,0b11110,0b10100,0b10010,0b10001} },
+    { 'S',{0b01111,0b10000,0b10000,0b01110,0b00001,0b00001,0b11110} },
+    { 'T',{0b11111,0b00100,0b00100,0b00100,0b00100,0b00100,0b00100} },
+    { 'U',{0b10001,0b10001,0b10001,0b10001,0b10001,0b10001,0b01110} },
+    { 'V',{0b10001,0b10001,0b10001,0b01010,0b01010,0b00100,0b00100} },
+    { 'W',{0b10001,0b10001,0b10101,0b10101,0b10101,0b11011,0b10001} },
+    { '0',{0b01110,0b10001,0b10011,0b10101,0b11001,0b10001,0b01110} },
+    { '1',{0b00100,0b01100,0b00100,0b00100,0b00100,0b00100,0b01110} },
+    { '2',{0b01110,0b10001,0b00001,0b00010,0b00100,0b01000,0b11111} },
+    { '3',{0b11110,0b00001,0b00001,0b01110,0b00001,0b00001,0b11110} },
+    { '4',{0b00010,0b00110,0b01010,0b10010,0b11111,0b00010,0b00010} },
+    { '5',{0b11111,0b10000,0b11110,0b00001,0b00001,0b10001,0b01110} },
+    { '6',{0b00110,0b01000,0b10000,0b11110,0b10001,0b10001,0b01110} },
+    { '7',{0b11111,0b00001,0b00010,0b00100,0b01000,0b01000,0b01000} },
+    { '8',{0b01110,0b10001,0b10001,0b01110,0b10001,0b10001,0b01110} },
+    { '9',{0b01110,0b10001,0b10001,0b01111,0b00001,0b00010,0b01100} },
+    { ' ',{0,0,0,0,0,0,0} },
+    { '-',{0,0,0b11111,0,0,0,0} },
+};
+inline const Glyph5x7* find_glyph(char c) {
+    for (auto& g : FONT) if (g.ch == c) return &g;
+    return &FONT[sizeof(FONT) / sizeof(FONT[0]) - 2]; 
+}
+inline void draw_text(SDL_Renderer* r, float x, float y, const std::string& s,
+    float scale = 2.0f, SDL_Color color = { 255,255,255,255 })
+{
+    SDL_SetRenderDrawColor(r, color.r, color.g, color.b, color.a);
+    float cx = x;
+    for (char c : s) {
+        const Glyph5x7* g = find_glyph((char)std::toupper((unsigned char)c));
+        for (int row = 0; row < 7; ++row) {
+            unsigned char bits = g->rows[row];
+            for (int col = 0; col < 5; ++col) {
+                if (bits & (1 << (4 - col))) {
+                    SDL_FRect px{ cx + col * scale, y + row * scale, scale, scale };
+                    render_fill_rect(r, &px);
+                }
+            }
+        }
+        cx += 6.0f * scale;
+    }
+}
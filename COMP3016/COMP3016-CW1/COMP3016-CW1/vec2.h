@@ -0,0 +1,46 @@
+﻿#pragma once
+
+#include <cmath>
+
+constexpr float PI = 3.14159265358979323846f;
+
+// math
+struct Vec2 {
+    float x{ 0 }, y{ 0 };
+    Vec2() = default;
+    Vec2(float X, float Y) : x(X), y(Y) {}
+    Vec2 operator+(const Vec2& o) const { return { x + o.x, y + o.y }; }
+    Vec2 operator-(const Vec2& o) const { return { x - o.x, y - o.y }; }
+    Vec2 operator*(float s) const { return { x * s, y * s }; }
+    Vec2& operator+=(const Vec2& o) { x += o.x; y += o.y; return *this; }
+    float len() const { return std::sqrt(x * x + y * y); }
+    Vec2 normalized() const { float L = len(); return (L > 0.0001f) ? Vec2{ x / L,y / L } : Vec2{ 0,0 }; }
+};
+
+inline bool circle_hit(const Vec2& a, float ar, const Vec2& b, float br) {
+    float dx = a.x - b.x, dy = a.y - b.y; float rr = (ar + br); rr *= rr;
+    return dx * dx + dy * dy <= rr;
+}
+
+// Swept test for two circles moving linearly over one step: a from a0 to a1,
+// b from b0 to b1. On a hit, *toi is the first time in [0,1] they touch
+// (0 if they already overlap at the start).
+inline bool swept_circle_hit(const Vec2& a0, const Vec2& a1, float ar,
+    const Vec2& b0, const Vec2& b1, float br, float* toi)
+{
+    // relative to a: b starts at s and moves by d
+    Vec2 s = b0 - a0;
+    Vec2 d = (b1 - b0) - (a1 - a0);
+    float rr = ar + br;
+    float c = s.x * s.x + s.y * s.y - rr * rr;
+    if (c <= 0.f) { *toi = 0.f; return true; }
+    float a = d.x * d.x + d.y * d.y;
+    float b = s.x * d.x + s.y * d.y;            // half of the usual b
+    if (a <= 1e-12f || b >= 0.f) return false;  // not moving, or moving apart
+    float disc = b * b - a * c;
+    if (disc < 0.f) return false;
+    float t = (-b - std::sqrt(disc)) / a;
+    if (t > 1.f) return false;
+    *toi = t;
+    return true;
+}
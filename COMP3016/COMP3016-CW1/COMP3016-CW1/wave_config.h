@@ -0,0 +1,103 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <string>
+
+#include "ai_lod.h"
+#include "crowd.h"
+
+// How waves scale with the wave number w (1-based), used by
+// Simulation::start_wave():
+//   zombies in the wave   firstCount + (w - 1) * countStep
+//   alive at once         min(firstCap + (w - 1) * capStep, maxCap)
+//   spawn interval        max(minSpawnInterval, spawnInterval * spawnDecay^(w - 1))
+//   speed                 zombieSpeed * (1 + speedStep * (w - 1))
+struct WaveCurve {
+    int   firstCount = 8;
+    int   countStep = 5;
+    int   firstCap = 6;
+    int   capStep = 2;
+    int   maxCap = 40;
+    float spawnDecay = 0.92f;
+    float minSpawnInterval = 0.20f;
+    float speedStep = 0.06f;
+    float intermissionSec = 3.0f;
+};
+
+// Tuning from data/waves.txt: "key = value" lines, # comments. Missing
+// file or keys keep the defaults.
+struct WaveConfig {
+    int   maxZombies = 20;
+    float zombieSpeed = 90.0f;
+    float spawnIntervalSec = 1.0f;
+    WaveCurve curve{};
+    CrowdConfig crowd{};
+    AiLodConfig lod{};
+};
+
+// reads the value of one waves.txt key from `in`; false if the key is unknown
+inline bool set_wave_key(WaveConfig& cfg, const std::string& k, std::istream& in) {
+    if (k == "maxZombies")          in >> cfg.maxZombies;
+    else if (k == "zombieSpeed")    in >> cfg.zombieSpeed;
+    else if (k == "spawnInterval")  in >> cfg.spawnIntervalSec;
+    else if (k == "waveCount")        in >> cfg.curve.firstCount;
+    else if (k == "waveCountStep")    in >> cfg.curve.countStep;
+    else if (k == "waveCap")          in >> cfg.curve.firstCap;
+    else if (k == "waveCapStep")      in >> cfg.curve.capStep;
+    else if (k == "waveCapMax")       in >> cfg.curve.maxCap;
+    else if (k == "spawnDecay")       in >> cfg.curve.spawnDecay;
+    else if (k == "spawnIntervalMin") in >> cfg.curve.minSpawnInterval;
+    else if (k == "speedStep")        in >> cfg.curve.speedStep;
+    else if (k == "intermission")     in >> cfg.curve.intermissionSec;
+    else if (k == "separationRadius") in >> cfg.crowd.radius;
+    else if (k == "separationWeight") in >> cfg.crowd.separationWeight;
+    else if (k == "cohesionWeight")   in >> cfg.crowd.cohesionWeight;
+    else if (k == "crowdNeighbours")  in >> cfg.crowd.maxNeighbours;
+    else if (k == "aiLod")            in >> cfg.lod.enabled;
+    else if (k == "aiNearRadius")     in >> cfg.lod.nearRadius;
+    else if (k == "aiMidRadius")      in >> cfg.lod.midRadius;
+    else if (k == "aiNearInterval")   in >> cfg.lod.nearInterval;
+    else if (k == "aiMidInterval")    in >> cfg.lod.midInterval;
+    else if (k == "aiFarInterval")    in >> cfg.lod.farInterval;
+    else if (k == "aiSteerBudget")    in >> cfg.lod.steerBudget;
+    else return false;
+    return true;
+}
+
+// clamps values that would break the simulation
+inline void sanitize_wave_config(WaveConfig& cfg) {
+    cfg.curve.firstCount = std::max(cfg.curve.firstCount, 1);
+    cfg.curve.countStep = std::max(cfg.curve.countStep, 0);
+    cfg.curve.maxCap = std::max(cfg.curve.maxCap, 1);
+    cfg.curve.firstCap = std::clamp(cfg.curve.firstCap, 1, cfg.curve.maxCap);
+    cfg.curve.capStep = std::max(cfg.curve.capStep, 0);
+    cfg.curve.spawnDecay = std::max(cfg.curve.spawnDecay, 0.f);
+    cfg.curve.minSpawnInterval = std::max(cfg.curve.minSpawnInterval, 0.f);
+    cfg.curve.intermissionSec = std::max(cfg.curve.intermissionSec, 0.f);
+    cfg.crowd.radius = std::max(cfg.crowd.radius, 1.f);
+    cfg.lod.midRadius = std::max(cfg.lod.midRadius, cfg.lod.nearRadius);
+    cfg.lod.nearInterval = std::max(cfg.lod.nearInterval, 1);
+    cfg.lod.midInterval = std::max(cfg.lod.midInterval, 1);
+    cfg.lod.farInterval = std::max(cfg.lod.farInterval, 1);
+    cfg.lod.steerBudget = std::max(cfg.lod.steerBudget, 0);
+}
+
+inline WaveConfig load_wave_config(const std::string& path) {
+    WaveConfig cfg{};
+    std::ifstream f(path);
+    if (!f.good()) return cfg;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string k, eq;
+        if (!(iss >> k >> eq)) continue;
+        if (eq != "=") continue;
+        set_wave_key(cfg, k, iss);
+    }
+    sanitize_wave_config(cfg);
+    return cfg;
+}
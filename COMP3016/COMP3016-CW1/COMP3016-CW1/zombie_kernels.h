@@ -0,0 +1,230 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "vec2.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ZOMBIE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define ZOMBIE_SIMD_X86 0
+#endif
+
+// GCC/Clang need the ISA enabled per function; MSVC accepts intrinsics anywhere
+#if ZOMBIE_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ZOMBIE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ZOMBIE_TARGET_AVX2
+#endif
+
+// No mul+add -> FMA contraction in the kernels (GCC contracts by default when
+// FMA is enabled, e.g. -march=native), otherwise precise mode would differ
+// between paths and between machines.
+#if defined(__clang__)
+#define ZOMBIE_NO_CONTRACT
+#define ZOMBIE_NO_CONTRACT_BODY _Pragma("clang fp contract(off)")
+#elif defined(__GNUC__)
+#define ZOMBIE_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#define ZOMBIE_NO_CONTRACT_BODY
+#else
+#define ZOMBIE_NO_CONTRACT
+#define ZOMBIE_NO_CONTRACT_BODY
+#endif
+
+// Fused zombie steering kernel: normalize the wanted direction, scale by
+// speed, update facing and (optionally) integrate and clamp to the arena,
+// 4 (SSE2) or 8 (AVX2) zombies per iteration, with a scalar fallback.
+// Position, velocity and facing are interleaved x,y columns (ECS Vec2
+// components); the wanted direction comes in as separate x and y arrays.
+//
+// precise = true uses the same IEEE sqrt/div/mul/add sequence on every path,
+// so SSE2/AVX2 results are bit-identical to the scalar loop (deterministic
+// mode). precise = false swaps sqrt+div for rsqrt plus one Newton step.
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+inline const char* simd_level_name(SimdLevel l) {
+    return l == SimdLevel::AVX2 ? "avx2" : l == SimdLevel::SSE2 ? "sse2" : "scalar";
+}
+
+inline SimdLevel detect_simd() {
+#if ZOMBIE_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4]{};
+    __cpuid(r, 0);
+    if (r[0] >= 7) {
+        __cpuidex(r, 7, 0);
+        bool avx2 = (r[1] & (1 << 5)) != 0;
+        __cpuid(r, 1);
+        bool osxsave = (r[2] & (1 << 27)) != 0;
+        if (avx2 && osxsave && (_xgetbv(0) & 6) == 6) return SimdLevel::AVX2;
+    }
+    return SimdLevel::SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#endif
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+struct ZombieKernelArgs {
+    Vec2* pos{};
+    Vec2* vel{};
+    const float* speed{};
+    const float* dirX{}; const float* dirY{};  // wanted direction, any length
+    Vec2* face{};
+    int n{ 0 };
+    bool integrate{ false };                   // also move by vel*dt and clamp
+    float dt{ 0.f };
+    float minX{}, minY{}, maxX{}, maxY{};
+};
+
+ZOMBIE_NO_CONTRACT
+inline void zombie_kernel_scalar(const ZombieKernelArgs& a, int begin) {
+    ZOMBIE_NO_CONTRACT_BODY
+    for (int i = begin; i < a.n; i++) {
+        float dx = a.dirX[i], dy = a.dirY[i];
+        float L = std::sqrt(dx * dx + dy * dy);
+        float nx = 0.f, ny = 0.f;
+        if (L > 0.0001f) { nx = dx / L; ny = dy / L; a.face[i] = Vec2{ nx, ny }; }
+        a.vel[i].x = nx * a.speed[i];
+        a.vel[i].y = ny * a.speed[i];
+        if (a.integrate) {
+            float px = a.pos[i].x + a.vel[i].x * a.dt;
+            float py = a.pos[i].y + a.vel[i].y * a.dt;
+            a.pos[i].x = std::min(std::max(px, a.minX), a.maxX);
+            a.pos[i].y = std::min(std::max(py, a.minY), a.maxY);
+        }
+    }
+}
+
+#if ZOMBIE_SIMD_X86
+ZOMBIE_NO_CONTRACT
+inline int zombie_kernel_sse2(const ZombieKernelArgs& a, bool precise) {
+    ZOMBIE_NO_CONTRACT_BODY
+    const __m128 eps = _mm_set1_ps(0.0001f), eps2 = _mm_set1_ps(1e-8f);
+    const __m128 half = _mm_set1_ps(0.5f), three = _mm_set1_ps(3.f);
+    const __m128 dt = _mm_set1_ps(a.dt);
+    const __m128 lo = _mm_setr_ps(a.minX, a.minY, a.minX, a.minY);
+    const __m128 hi = _mm_setr_ps(a.maxX, a.maxY, a.maxX, a.maxY);
+    int i = 0;
+    for (; i + 4 <= a.n; i += 4) {
+        __m128 dx = _mm_loadu_ps(a.dirX + i), dy = _mm_loadu_ps(a.dirY + i);
+        __m128 l2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 nx, ny, ok;
+        if (precise) {
+            __m128 L = _mm_sqrt_ps(l2);
+            ok = _mm_cmpgt_ps(L, eps);
+            nx = _mm_and_ps(ok, _mm_div_ps(dx, L));
+            ny = _mm_and_ps(ok, _mm_div_ps(dy, L));
+        }
+        else {
+            ok = _mm_cmpgt_ps(l2, eps2);
+            __m128 r = _mm_rsqrt_ps(l2);
+            r = _mm_mul_ps(_mm_mul_ps(half, r), _mm_sub_ps(three, _mm_mul_ps(l2, _mm_mul_ps(r, r))));
+            nx = _mm_and_ps(ok, _mm_mul_ps(dx, r));
+            ny = _mm_and_ps(ok, _mm_mul_ps(dy, r));
+        }
+        __m128 spd = _mm_loadu_ps(a.speed + i);
+        __m128 vx = _mm_mul_ps(nx, spd), vy = _mm_mul_ps(ny, spd);
+
+        // back to interleaved x,y: zombies i, i+1 then i+2, i+3
+        __m128 vLo = _mm_unpacklo_ps(vx, vy), vHi = _mm_unpackhi_ps(vx, vy);
+        float* v = &a.vel[i].x;
+        _mm_storeu_ps(v, vLo);
+        _mm_storeu_ps(v + 4, vHi);
+
+        // keep the old facing where dir was ~0
+        float* f = &a.face[i].x;
+        __m128 okLo = _mm_unpacklo_ps(ok, ok), okHi = _mm_unpackhi_ps(ok, ok);
+        __m128 fLo = _mm_unpacklo_ps(nx, ny), fHi = _mm_unpackhi_ps(nx, ny);
+        __m128 oldLo = _mm_loadu_ps(f), oldHi = _mm_loadu_ps(f + 4);
+        _mm_storeu_ps(f, _mm_or_ps(_mm_and_ps(okLo, fLo), _mm_andnot_ps(okLo, oldLo)));
+        _mm_storeu_ps(f + 4, _mm_or_ps(_mm_and_ps(okHi, fHi), _mm_andnot_ps(okHi, oldHi)));
+
+        if (a.integrate) {
+            float* p = &a.pos[i].x;
+            __m128 pLo = _mm_add_ps(_mm_loadu_ps(p), _mm_mul_ps(vLo, dt));
+            __m128 pHi = _mm_add_ps(_mm_loadu_ps(p + 4), _mm_mul_ps(vHi, dt));
+            _mm_storeu_ps(p, _mm_min_ps(_mm_max_ps(pLo, lo), hi));
+            _mm_storeu_ps(p + 4, _mm_min_ps(_mm_max_ps(pHi, lo), hi));
+        }
+    }
+    return i;
+}
+
+ZOMBIE_TARGET_AVX2 ZOMBIE_NO_CONTRACT
+inline int zombie_kernel_avx2(const ZombieKernelArgs& a, bool precise) {
+    ZOMBIE_NO_CONTRACT_BODY
+    const __m256 eps = _mm256_set1_ps(0.0001f), eps2 = _mm256_set1_ps(1e-8f);
+    const __m256 half = _mm256_set1_ps(0.5f), three = _mm256_set1_ps(3.f);
+    const __m256 dt = _mm256_set1_ps(a.dt);
+    const __m256 lo = _mm256_setr_ps(a.minX, a.minY, a.minX, a.minY, a.minX, a.minY, a.minX, a.minY);
+    const __m256 hi = _mm256_setr_ps(a.maxX, a.maxY, a.maxX, a.maxY, a.maxX, a.maxY, a.maxX, a.maxY);
+    int i = 0;
+    for (; i + 8 <= a.n; i += 8) {
+        __m256 dx = _mm256_loadu_ps(a.dirX + i), dy = _mm256_loadu_ps(a.dirY + i);
+        __m256 l2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 nx, ny, ok;
+        if (precise) {
+            __m256 L = _mm256_sqrt_ps(l2);
+            ok = _mm256_cmp_ps(L, eps, _CMP_GT_OQ);
+            nx = _mm256_and_ps(ok, _mm256_div_ps(dx, L));
+            ny = _mm256_and_ps(ok, _mm256_div_ps(dy, L));
+        }
+        else {
+            ok = _mm256_cmp_ps(l2, eps2, _CMP_GT_OQ);
+            __m256 r = _mm256_rsqrt_ps(l2);
+            r = _mm256_mul_ps(_mm256_mul_ps(half, r), _mm256_sub_ps(three, _mm256_mul_ps(l2, _mm256_mul_ps(r, r))));
+            nx = _mm256_and_ps(ok, _mm256_mul_ps(dx, r));
+            ny = _mm256_and_ps(ok, _mm256_mul_ps(dy, r));
+        }
+        __m256 spd = _mm256_loadu_ps(a.speed + i);
+        __m256 vx = _mm256_mul_ps(nx, spd), vy = _mm256_mul_ps(ny, spd);
+
+        // unpack works per 128-bit lane: lo = zombies 0,1,4,5 and hi = 2,3,6,7,
+        // permute2f128 puts them back in memory order
+        __m256 vLo = _mm256_unpacklo_ps(vx, vy), vHi = _mm256_unpackhi_ps(vx, vy);
+        __m256 v0 = _mm256_permute2f128_ps(vLo, vHi, 0x20), v1 = _mm256_permute2f128_ps(vLo, vHi, 0x31);
+        float* v = &a.vel[i].x;
+        _mm256_storeu_ps(v, v0);
+        _mm256_storeu_ps(v + 8, v1);
+
+        float* f = &a.face[i].x;
+        __m256 okLo = _mm256_unpacklo_ps(ok, ok), okHi = _mm256_unpackhi_ps(ok, ok);
+        __m256 fLo = _mm256_unpacklo_ps(nx, ny), fHi = _mm256_unpackhi_ps(nx, ny);
+        __m256 ok0 = _mm256_permute2f128_ps(okLo, okHi, 0x20), ok1 = _mm256_permute2f128_ps(okLo, okHi, 0x31);
+        __m256 f0 = _mm256_permute2f128_ps(fLo, fHi, 0x20), f1 = _mm256_permute2f128_ps(fLo, fHi, 0x31);
+        _mm256_storeu_ps(f, _mm256_blendv_ps(_mm256_loadu_ps(f), f0, ok0));
+        _mm256_storeu_ps(f + 8, _mm256_blendv_ps(_mm256_loadu_ps(f + 8), f1, ok1));
+
+        if (a.integrate) {
+            float* p = &a.pos[i].x;
+            __m256 p0 = _mm256_add_ps(_mm256_loadu_ps(p), _mm256_mul_ps(v0, dt));
+            __m256 p1 = _mm256_add_ps(_mm256_loadu_ps(p + 8), _mm256_mul_ps(v1, dt));
+            _mm256_storeu_ps(p, _mm256_min_ps(_mm256_max_ps(p0, lo), hi));
+            _mm256_storeu_ps(p + 8, _mm256_min_ps(_mm256_max_ps(p1, lo), hi));
+        }
+    }
+    return i;
+}
+#endif
+
+inline void zombie_kernel(const ZombieKernelArgs& a, SimdLevel level, bool precise) {
+    int done = 0;
+#if ZOMBIE_SIMD_X86
+    if (level == SimdLevel::AVX2) done = zombie_kernel_avx2(a, precise);
+    else if (level == SimdLevel::SSE2) done = zombie_kernel_sse2(a, precise);
+#else
+    (void)level; (void)precise;
+#endif
+    zombie_kernel_scalar(a, done);
+}
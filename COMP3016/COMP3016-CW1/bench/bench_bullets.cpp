@@ -0,0 +1,79 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "components.h"
+
+// Bullet churn: fire, age, expire and remove every tick, with the bullet
+// archetype compacting in order vs swap-and-pop into a fixed capacity.
+// Also counts heap allocations after start-up; the fixed pool must make
+// none (exit code 1 otherwise).
+//
+// usage: bench_bullets [ticks]
+
+static long long g_allocs = 0;
+
+void* operator new(std::size_t n) {
+    g_allocs++;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+struct Result { double msPerTick; long long allocs; int peak; };
+
+// cap bullets alive at most; each tick fires `perTick` and some expire
+static Result run(int ticks, int cap, int perTick, bool fixed) {
+    BulletArch bs;
+    if (fixed) { bs.set_capacity(cap); bs.set_swap_remove(true); }
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> life(0.2f, 1.2f), ang(0.f, 2.f * PI);
+    const float dt = 1.f / 60.f;
+
+    long long allocsBefore = 0;
+    int peak = 0;
+    double ms = 0;
+    for (int t = 0; t < ticks; t++) {
+        if (t == 10) allocsBefore = g_allocs;  // the unfixed vectors grow in the first ticks
+        auto t0 = bench_clock::now();
+        for (int k = 0; k < perTick; k++) {
+            float a = ang(rng);
+            Vec2 v{ std::cos(a) * 620.f, std::sin(a) * 620.f };
+            spawn_bullet(bs, Vec2{ 480,270 }, v, life(rng));
+        }
+        Transform* tf = bs.data<Transform>();
+        const Velocity* vel = bs.data<Velocity>();
+        Lifetime* lt = bs.data<Lifetime>();
+        for (int i = 0; i < bs.size(); i++) {
+            lt[i].age += dt;
+            if (lt[i].age >= lt[i].life) bs.alive[i] = 0;
+            tf[i].pos += vel[i].vel * dt;
+        }
+        peak = std::max(peak, bs.size());
+        bs.remove_dead();
+        ms += ms_since(t0);
+    }
+    return { ms / ticks, g_allocs - allocsBefore, peak };
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(20, std::atoi(argv[1])) : 600;
+    const int rates[] = { 10, 100, 1000 };
+
+    std::printf("%d ticks, lifetimes 0.2-1.2 s\n\n", ticks);
+    std::printf("%-10s %-8s %10s %8s %10s\n", "fired/tick", "pool", "ms/tick", "peak", "allocs");
+    int failures = 0;
+    for (int rate : rates) {
+        int cap = (int)(rate * 1.2f * 60.f) + rate;   // everything fired within one max lifetime
+        Result a = run(ticks, cap, rate, false);
+        Result b = run(ticks, cap, rate, true);
+        if (b.allocs != 0) failures++;
+        std::printf("%-10d %-8s %10.4f %8d %10lld\n", rate, "ordered", a.msPerTick, a.peak, a.allocs);
+        std::printf("%-10d %-8s %10.4f %8d %10lld\n", rate, "fixed", b.msPerTick, b.peak, b.allocs);
+    }
+    return failures ? 1 : 0;
+}
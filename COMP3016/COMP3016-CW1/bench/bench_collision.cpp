@@ -0,0 +1,97 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "spatial_grid.h"
+#include "vec2.h"
+
+// Bullet -> zombie broadphase: brute-force Z x B loop against the uniform
+// grid used by Game::update. Reports circle_hit calls and time per tick and
+// checks both paths kill exactly the same zombies.
+//
+// usage: bench_collision [ticks]
+
+struct Body { Vec2 pos; float radius; bool alive; };
+
+struct Case { const char* name; int zombies; int bullets; };
+
+static const Case CASES[] = {
+    { "cap40+volley",      40,    36 },
+    { "z500/b200",        500,   200 },
+    { "z5k/b1k",         5000,  1000 },
+    { "z20k/b4k",       20000,  4000 },
+};
+
+static long long brute(std::vector<Body>& zs, std::vector<Body>& bs) {
+    long long tests = 0;
+    for (auto& z : zs) {
+        for (auto& b : bs) {
+            if (!z.alive || !b.alive) continue;
+            tests++;
+            if (circle_hit(z.pos, z.radius, b.pos, b.radius)) { z.alive = false; b.alive = false; }
+        }
+    }
+    return tests;
+}
+
+static long long gridded(SpatialGrid& grid, std::vector<Body>& zs, std::vector<Body>& bs) {
+    long long tests = 0;
+    grid.build((int)bs.size(), [&](int i) { return bs[i].pos; });
+    for (auto& z : zs) {
+        if (!z.alive) continue;
+        int hit = -1;
+        grid.query_radius(z.pos, z.radius + 4.f, [&](int i) {
+            const Body& b = bs[i];
+            if (!b.alive || (hit >= 0 && i > hit)) return;
+            tests++;
+            if (circle_hit(z.pos, z.radius, b.pos, b.radius)) hit = i;
+        });
+        if (hit >= 0) { z.alive = false; bs[hit].alive = false; }
+    }
+    return tests;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 50;
+
+    std::printf("%d ticks per case\n\n", ticks);
+    std::printf("%-14s %8s %14s %12s %10s %10s %8s %6s\n",
+        "case", "world", "brute tests", "grid tests", "brute ms", "grid ms", "speedup", "same");
+
+    for (const Case& c : CASES) {
+        // keep the crowd density of a 40-zombie arena as the counts grow
+        float s = std::max(1.f, std::sqrt(c.zombies / 500.f));
+        float W = 960.f * s, H = 540.f * s;
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dx(20.f, W - 20.f), dy(20.f, H - 20.f);
+        std::vector<Body> zs0, bs0;
+        for (int i = 0; i < c.zombies; i++) zs0.push_back({ { dx(rng), dy(rng) }, 14.f, true });
+        for (int i = 0; i < c.bullets; i++) bs0.push_back({ { dx(rng), dy(rng) }, 4.f, true });
+
+        SpatialGrid grid;
+        grid.reset(W, H, 28.f);
+
+        long long bruteTests = 0, gridTests = 0;
+        double bruteMs = 0, gridMs = 0;
+        bool same = true;
+        for (int t = 0; t < ticks; t++) {
+            auto zs1 = zs0, bs1 = bs0, zs2 = zs0, bs2 = bs0;
+            auto t0 = bench_clock::now();
+            bruteTests += brute(zs1, bs1);
+            bruteMs += ms_since(t0);
+            t0 = bench_clock::now();
+            gridTests += gridded(grid, zs2, bs2);
+            gridMs += ms_since(t0);
+            for (size_t i = 0; i < zs1.size(); i++) same &= zs1[i].alive == zs2[i].alive;
+            for (size_t i = 0; i < bs1.size(); i++) same &= bs1[i].alive == bs2[i].alive;
+        }
+
+        std::printf("%-14s %4.0fx%-4.0f %14lld %12lld %10.4f %10.4f %7.1fx %6s\n",
+            c.name, W, H, bruteTests / ticks, gridTests / ticks, bruteMs / ticks, gridMs / ticks,
+            gridMs > 0 ? bruteMs / gridMs : 0.0, same ? "yes" : "NO");
+    }
+    return 0;
+}
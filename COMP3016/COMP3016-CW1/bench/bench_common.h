@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// Shared helpers for the benchmark executables.
+using bench_clock = std::chrono::steady_clock;
+
+inline double ms_since(bench_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - t0).count();
+}
+
+struct Samples {
+    std::vector<double> v;
+
+    void add(double x) { v.push_back(x); }
+    double mean() const {
+        double s = 0; for (double x : v) s += x;
+        return v.empty() ? 0.0 : s / (double)v.size();
+    }
+    double stddev() const {
+        if (v.size() < 2) return 0.0;
+        double m = mean(), s = 0; for (double x : v) s += (x - m) * (x - m);
+        return std::sqrt(s / (double)(v.size() - 1));
+    }
+    double min() const { return v.empty() ? 0.0 : *std::min_element(v.begin(), v.end()); }
+    double max() const { return v.empty() ? 0.0 : *std::max_element(v.begin(), v.end()); }
+};
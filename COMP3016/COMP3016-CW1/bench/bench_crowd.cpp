@@ -0,0 +1,71 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "crowd.h"
+#include "spatial_grid.h"
+#include "vec2.h"
+
+// Crowd steering cost: grid rebuild + separation/cohesion + seek + integrate
+// for N zombies chasing a point, at a fixed 60 Hz step.
+//
+// usage: bench_crowd [ticks]
+
+struct Agent { Vec2 pos, vel; float speed; };
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 120;
+    const float dt = 1.f / 60.f;
+    const int counts[] = { 1000, 5000, 10000, 20000 };
+
+    std::printf("%d ticks per case, 60 Hz budget = 16.7 ms\n\n", ticks);
+    std::printf("%-8s %10s %10s %10s %14s\n", "zombies", "world", "ms/tick", "max ms", "min spacing");
+
+    for (int n : counts) {
+        // roughly the same density for every count
+        float s = std::max(1.f, std::sqrt(n / 1000.f));
+        float W = 960.f * s, H = 540.f * s;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dx(20.f, W - 20.f), dy(20.f, H - 20.f);
+        std::vector<Agent> zs;
+        for (int i = 0; i < n; i++) zs.push_back({ { dx(rng), dy(rng) }, {}, 90.f });
+
+        CrowdConfig cfg{};
+        SpatialGrid grid;
+        grid.reset(W, H, cfg.radius);
+        Vec2 target{ W * 0.5f, H * 0.5f };
+
+        Samples ms;
+        for (int t = 0; t < ticks; t++) {
+            auto t0 = bench_clock::now();
+            grid.build(n, [&](int i) { return zs[i].pos; });
+            for (int i = 0; i < n; i++) {
+                Vec2 crowd = crowd_force(i, zs[i].pos, grid, [&](int j) { return zs[j].pos; }, cfg);
+                zs[i].vel = ((target - zs[i].pos).normalized() + crowd).normalized() * zs[i].speed;
+            }
+            for (auto& z : zs) {
+                z.pos += z.vel * dt;
+                z.pos.x = std::clamp(z.pos.x, 20.f, W - 20.f);
+                z.pos.y = std::clamp(z.pos.y, 20.f, H - 20.f);
+            }
+            ms.add(ms_since(t0));
+        }
+
+        // how tightly the horde packed around the target
+        grid.build(n, [&](int i) { return zs[i].pos; });
+        double spacing = 0;
+        for (int i = 0; i < n; i++) {
+            float best = cfg.radius;
+            grid.query_radius(zs[i].pos, cfg.radius, [&](int j) {
+                if (j != i) best = std::min(best, (zs[i].pos - zs[j].pos).len());
+            });
+            spacing += best;
+        }
+
+        std::printf("%-8d %5.0fx%-4.0f %10.3f %10.3f %11.1f px\n", n, W, H, ms.mean(), ms.max(), spacing / n);
+    }
+    return 0;
+}
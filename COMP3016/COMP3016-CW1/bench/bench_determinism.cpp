@@ -0,0 +1,108 @@
+﻿#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "game.h"
+
+// Deterministic mode: the same seed and the same scripted input must give
+// the same state hash on every tick; a different seed must not. The first
+// diverging tick is reported and makes the exit code non-zero. Also times
+// state_hash() at large horde sizes.
+// Headless (dummy video driver, software renderer); run from the project
+// directory so data/ is found.
+//
+// usage: bench_determinism [ticks]
+
+static const int WIDTH = 960, HEIGHT = 540;
+
+// walk a square, circle the aim around the player, fire every few ticks
+// and switch weapons now and then
+static void scripted_input(Game& game, int t, bool* keys, float& mx, float& my) {
+    keys[SDL_SCANCODE_W] = keys[SDL_SCANCODE_A] = keys[SDL_SCANCODE_S] = keys[SDL_SCANCODE_D] = false;
+    const SDL_Scancode walk[4] = { SDL_SCANCODE_D, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_W };
+    keys[walk[(t / 45) % 4]] = true;
+
+    float a = t * 0.05f;
+    mx = WIDTH * 0.5f + std::cos(a) * 200.f;
+    my = HEIGHT * 0.5f + std::sin(a) * 150.f;
+
+    SDL_Event e{};
+    if (t % 300 == 0) {
+        e.type = SDL_EVENT_KEY_DOWN;
+        e.key.key = (t / 300) % 3 == 0 ? SDLK_1 : (t / 300) % 3 == 1 ? SDLK_2 : SDLK_3;
+        game.handle_event(e);
+    }
+    if (t % 3 == 0) {
+        e = SDL_Event{};
+        e.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+        e.button.button = SDL_BUTTON_LEFT;
+        game.handle_event(e);
+    }
+}
+
+static std::vector<uint64_t> run(SDL_Renderer* r, uint32_t seed, int ticks) {
+    DeterminismConfig det;
+    det.enabled = true;
+    det.seed = seed;
+    Game game(r, nullptr, WIDTH, HEIGHT, det);
+
+    bool keys[SDL_SCANCODE_COUNT]{};
+    std::vector<uint64_t> hashes;
+    for (int t = 0; t < ticks; t++) {
+        float mx = 0.f, my = 0.f;
+        scripted_input(game, t, keys, mx, my);
+        game.update(game.sim().fixed_tick(), keys, mx, my);
+        hashes.push_back(game.sim().last_hash());
+    }
+    return hashes;
+}
+
+static int first_difference(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    for (size_t i = 0; i < a.size() && i < b.size(); i++)
+        if (a[i] != b[i]) return (int)i + 1;
+    return a.size() == b.size() ? -1 : (int)std::min(a.size(), b.size()) + 1;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(10, std::atoi(argv[1])) : 3600;
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_VIDEO)) { std::fprintf(stderr, "SDL_Init: %s\n", SDL_GetError()); return 1; }
+    SDL_Surface* target = SDL_CreateSurface(WIDTH, HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer* r = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!r) { std::fprintf(stderr, "software renderer: %s\n", SDL_GetError()); SDL_Quit(); return 1; }
+
+    int failures = 0;
+    std::vector<uint64_t> a = run(r, 42, ticks), b = run(r, 42, ticks), c = run(r, 43, ticks);
+    int same = first_difference(a, b), other = first_difference(a, c);
+    std::printf("%d ticks at 1/60 s\n", ticks);
+    if (same < 0) std::printf("seed 42 vs 42: identical, final hash %016llx\n", (unsigned long long)a.back());
+    else { std::printf("seed 42 vs 42: DIVERGED at tick %d\n", same); failures++; }
+    if (other > 0) std::printf("seed 42 vs 43: diverge at tick %d\n", other);
+    else { std::printf("seed 42 vs 43: IDENTICAL (hash misses state)\n"); failures++; }
+
+    std::printf("\n%-9s %12s\n", "zombies", "hash ms");
+    {
+        Simulation sim(WIDTH, HEIGHT);
+        for (int n : { 1000, 10000, 100000 }) {
+            sim.load_scene(n, n / 10);
+            Samples ms;
+            uint64_t sink = 0;
+            for (int i = 0; i < 20; i++) {
+                auto t0 = bench_clock::now();
+                sink = sim.state_hash();
+                ms.add(ms_since(t0));
+            }
+            std::printf("%-9d %12.3f   (%016llx)\n", n, ms.mean(), (unsigned long long)sink);
+        }
+    }
+
+    SDL_DestroyRenderer(r);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "components.h"
+#include "vec2.h"
+
+// Per-entity cost of the update + draw-prep loop, by dispatch style.
+//   virtual/ptr  old model: Entity base with virtual update/draw, objects
+//                behind base pointers
+//   virtual/vec  same classes stored by value, still called through the vtable
+//   static/vec   no virtuals, concrete type known (the Entity/Player model now)
+//   free/ecs     free functions over ZombieArch columns (what Game does)
+// "draw" computes the sprite rect and sums it into a sink instead of calling
+// SDL, so only the dispatch and memory layout differ.
+//
+// usage: bench_dispatch [reps]
+
+struct Rect { float x, y, w, h; };
+struct Sink {
+    double acc{ 0 };
+    void add(const Rect& r) { acc += r.x + r.y + r.w + r.h; }
+};
+
+namespace virt {
+struct Entity {
+    Vec2 pos, vel;
+    float radius{ 14.f };
+    bool alive{ true };
+    virtual ~Entity() = default;
+    virtual void update(float dt) { pos += vel * dt; }
+    virtual void draw(Sink& s) const = 0;
+};
+struct Zombie : Entity {
+    float speed{ 90.f };
+    Vec2 faceDir{ 1,0 };
+    void update(float dt) override {
+        Vec2 d = (Vec2{ 480,270 } - pos).normalized();
+        vel = d * speed; faceDir = d;
+        pos += vel * dt;
+    }
+    void draw(Sink& s) const override { s.add({ pos.x - radius, pos.y - radius, radius * 2, radius * 2 }); }
+};
+}
+
+namespace stat {
+struct Entity {
+    Vec2 pos, vel;
+    float radius{ 14.f };
+    bool alive{ true };
+};
+struct Zombie : Entity {
+    float speed{ 90.f };
+    Vec2 faceDir{ 1,0 };
+    void update(float dt) {
+        Vec2 d = (Vec2{ 480,270 } - pos).normalized();
+        vel = d * speed; faceDir = d;
+        pos += vel * dt;
+    }
+    void draw(Sink& s) const { s.add({ pos.x - radius, pos.y - radius, radius * 2, radius * 2 }); }
+};
+}
+
+static void update_ecs(ZombieArch& zs, float dt) {
+    Transform* tf = zs.data<Transform>();
+    Velocity* vel = zs.data<Velocity>();
+    Sprite* sp = zs.data<Sprite>();
+    const AI* ai = zs.data<AI>();
+    for (int i = 0; i < zs.size(); i++) {
+        Vec2 d = (Vec2{ 480,270 } - tf[i].pos).normalized();
+        vel[i].vel = d * ai[i].speed;
+        sp[i].faceDir = d;
+        tf[i].pos += vel[i].vel * dt;
+    }
+}
+
+static void draw_ecs(const ZombieArch& zs, Sink& s) {
+    const Transform* tf = zs.data<Transform>();
+    const Collider* col = zs.data<Collider>();
+    for (int i = 0; i < zs.size(); i++) {
+        float r = col[i].radius;
+        s.add({ tf[i].pos.x - r, tf[i].pos.y - r, r * 2, r * 2 });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int reps = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 100;
+    const float dt = 1.f / 60.f;
+    const int counts[] = { 1000, 10000, 100000 };
+
+    std::printf("%d reps, update + draw-prep per entity\n", reps);
+    std::printf("sizeof: virt::Zombie %zu B, stat::Zombie %zu B\n\n", sizeof(virt::Zombie), sizeof(stat::Zombie));
+    std::printf("%-8s %-12s %10s\n", "n", "layout", "ns/entity");
+
+    for (int n : counts) {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> px(20.f, 940.f), py(20.f, 520.f);
+        std::vector<Vec2> start(n);
+        for (auto& p : start) p = { px(rng), py(rng) };
+
+        // pointers are allocated interleaved with junk so they scatter like
+        // objects created over a play session
+        std::vector<std::unique_ptr<virt::Entity>> ptrs;
+        std::vector<std::unique_ptr<char[]>> junk;
+        std::vector<virt::Zombie> vvec(n);
+        std::vector<stat::Zombie> svec(n);
+        ZombieArch pool;
+        for (int i = 0; i < n; i++) {
+            auto z = std::make_unique<virt::Zombie>(); z->pos = start[i];
+            ptrs.push_back(std::move(z));
+            junk.push_back(std::make_unique<char[]>(64 + (i % 7) * 16));
+            vvec[i].pos = start[i]; svec[i].pos = start[i];
+            spawn_zombie_at(pool, start[i], 90.f);
+        }
+
+        Sink sink;
+        auto run = [&](const char* name, auto&& tick) {
+            auto t0 = bench_clock::now();
+            for (int r = 0; r < reps; r++) tick();
+            std::printf("%-8d %-12s %10.3f\n", n, name, ms_since(t0) * 1e6 / ((double)reps * n));
+        };
+        run("virtual/ptr", [&] {
+            for (auto& e : ptrs) e->update(dt);
+            for (auto& e : ptrs) e->draw(sink);
+        });
+        run("virtual/vec", [&] {
+            for (virt::Entity& e : vvec) e.update(dt);
+            for (const virt::Entity& e : vvec) e.draw(sink);
+        });
+        run("static/vec", [&] {
+            for (auto& z : svec) z.update(dt);
+            for (const auto& z : svec) z.draw(sink);
+        });
+        run("free/ecs", [&] {
+            update_ecs(pool, dt);
+            draw_ecs(pool, sink);
+        });
+        std::printf("\n");
+        if (sink.acc == 0.0) std::printf("(sink %f)\n", sink.acc);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "components.h"
+
+// Zombie archetype with generational handles: spawn/kill churn cost, handle
+// lookup cost, and a correctness pass. Every handle to a removed zombie must
+// stop resolving and every live handle must still find its own zombie after
+// swap-removal reshuffled the rows (exit code 1 otherwise).
+//
+// usage: bench_handles [ticks]
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 300;
+    const int counts[] = { 1000, 10000, 100000 };
+
+    std::printf("%d ticks, 5%% of zombies killed and respawned per tick\n\n", ticks);
+    std::printf("%-8s %14s %14s %8s\n", "zombies", "churn ms/tick", "lookup ns/op", "check");
+    int failures = 0;
+    for (int n : counts) {
+        ZombieArch zs;
+        zs.set_handles(true);
+        zs.set_swap_remove(true);
+        zs.reserve(n);
+
+        // AI.speed doubles as an id so a handle can be checked against its zombie
+        std::vector<Handle> live;
+        std::vector<float> liveId;
+        float nextId = 0.f;
+        auto spawn = [&] {
+            int row = spawn_zombie_at(zs, Vec2{}, nextId);
+            live.push_back(zs.handle(row));
+            liveId.push_back(nextId);
+            nextId += 1.f;
+        };
+        for (int i = 0; i < n; i++) spawn();
+
+        std::mt19937 rng(4);
+        std::vector<Handle> dead;
+        double churnMs = 0;
+        bool ok = true;
+        for (int t = 0; t < ticks; t++) {
+            auto t0 = bench_clock::now();
+            for (int k = 0; k < n / 20; k++) {
+                size_t j = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+                int row = zs.row_of(live[j]);
+                if (row < 0) { ok = false; break; }
+                zs.alive[row] = 0;
+                dead.push_back(live[j]);
+                live[j] = live.back(); live.pop_back();
+                liveId[j] = liveId.back(); liveId.pop_back();
+            }
+            zs.remove_dead();
+            while ((int)live.size() < n) spawn();
+            churnMs += ms_since(t0);
+        }
+
+        for (Handle h : dead) if (zs.row_of(h) >= 0) ok = false;
+        for (size_t j = 0; j < live.size(); j++) {
+            int row = zs.row_of(live[j]);
+            if (row < 0 || zs.get<AI>(row).speed != liveId[j] || zs.handle(row) != live[j]) ok = false;
+        }
+        if (zs.size() != n) ok = false;
+
+        const int lookups = 1000000;
+        auto t0 = bench_clock::now();
+        long long sum = 0;
+        for (int i = 0; i < lookups; i++) sum += zs.row_of(live[(size_t)i % live.size()]);
+        double ns = ms_since(t0) * 1e6 / lookups;
+
+        if (!ok) failures++;
+        std::printf("%-8d %14.4f %14.3f %8s\n", n, churnMs / ticks, ns, ok ? "ok" : "FAIL");
+        if (sum == -1) std::printf("\n");
+    }
+    return failures ? 1 : 0;
+}
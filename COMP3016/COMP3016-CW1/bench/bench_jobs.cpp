@@ -0,0 +1,163 @@
+﻿#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench_common.h"
+#include "job_system.h"
+
+// Job system (job_system.h).
+//  1. checks, at 1, 2, 4 and 8 threads: parallel_for visits every index once
+//     in whole grain-sized chunks (also nested), a random task graph never
+//     runs a task before its predecessors, main-thread tasks and post_main
+//     jobs only run on the main thread, and jobs spawned from jobs are all
+//     waited for. Any failure makes the exit code non-zero. Build with
+//     -fsanitize=thread to check for races as well.
+//  2. spawn overhead: spawn + run + wait of empty jobs, ns per job.
+//  3. steal latency: time from a push on the main thread until another
+//     thread starts the job, with the workers spinning (hot) or asleep
+//     (cold).
+//
+// usage: bench_jobs [jobs]
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, int threads) {
+    if (ok) return;
+    std::printf("FAIL  %s (%d threads)\n", what, threads);
+    failures++;
+}
+
+static void check_parallel_for(JobSystem& js) {
+    const int sizes[] = { 0, 1, 7, 1000, 100003 }, grains[] = { 1, 64, 4096 };
+    for (int n : sizes) {
+        for (int grain : grains) {
+            std::vector<std::atomic<int>> seen(n);
+            std::atomic<int> badChunks{ 0 };
+            js.parallel_for(n, grain, [&](int b, int e) {
+                if (b % grain != 0 || (e - b != grain && e != n)) badChunks++;
+                for (int i = b; i < e; i++) seen[i].fetch_add(1, std::memory_order_relaxed);
+            });
+            bool once = true;
+            for (int i = 0; i < n; i++) once &= seen[i].load() == 1;
+            check(once && badChunks == 0, "parallel_for coverage", js.thread_count());
+        }
+    }
+
+    // nested: every outer chunk runs an inner loop and waits on it
+    std::atomic<long long> sum{ 0 };
+    js.parallel_for(64, 1, [&](int b, int) {
+        js.parallel_for(1000, 100, [&](int ib, int ie) {
+            long long s = 0;
+            for (int i = ib; i < ie; i++) s += (long long)b * 1000 + i;
+            sum += s;
+        });
+    });
+    long long want = 0;
+    for (int b = 0; b < 64; b++) for (int i = 0; i < 1000; i++) want += (long long)b * 1000 + i;
+    check(sum == want, "nested parallel_for", js.thread_count());
+}
+
+static void check_task_graph(JobSystem& js) {
+    const int N = 2000;
+    std::mt19937 rng(41);
+    std::vector<std::atomic<int>> finished(N);
+    std::vector<std::vector<int>> preds(N);
+    std::atomic<int> early{ 0 }, offMain{ 0 };
+    TaskGraph g;
+    for (int i = 0; i < N; i++) {
+        bool onMain = (i % 97) == 0;
+        g.add([&, i, onMain] {
+            for (int p : preds[i]) if (!finished[p].load(std::memory_order_acquire)) early++;
+            if (onMain && !js.on_main_thread()) offMain++;
+            finished[i].store(1, std::memory_order_release);
+        }, onMain);
+    }
+    for (int i = 1; i < N; i++) {
+        int edges = std::uniform_int_distribution<int>(0, 3)(rng);
+        for (int k = 0; k < edges; k++) {
+            int p = std::uniform_int_distribution<int>(std::max(0, i - 50), i - 1)(rng);
+            g.precede(p, i);
+            preds[i].push_back(p);
+        }
+    }
+    for (int run = 0; run < 2; run++) {
+        for (auto& f : finished) f.store(0);
+        js.run(g);
+        int all = 0;
+        for (auto& f : finished) all += f.load();
+        check(all == N, "task graph ran every task", js.thread_count());
+    }
+    check(early == 0, "task graph dependency order", js.thread_count());
+    check(offMain == 0, "main-thread tasks on the main thread", js.thread_count());
+}
+
+static void check_spawn_and_main_queue(JobSystem& js) {
+    // jobs spawning jobs, each level waiting on its own counter
+    std::atomic<int> leaves{ 0 };
+    JobCounter top;
+    for (int i = 0; i < 32; i++) {
+        js.spawn([&] {
+            JobCounter inner;
+            for (int k = 0; k < 32; k++) js.spawn([&] { leaves++; }, inner);
+            js.wait(inner);
+        }, top);
+    }
+    js.wait(top);
+    check(leaves == 32 * 32, "spawn from jobs", js.thread_count());
+
+    // post_main from workers, drained by the main thread
+    std::atomic<int> posted{ 0 }, ranOffMain{ 0 };
+    JobCounter c;
+    for (int i = 0; i < 64; i++)
+        js.spawn([&] { js.post_main([&] { posted++; if (!js.on_main_thread()) ranOffMain++; }); }, c);
+    js.wait(c);
+    js.run_main();
+    check(posted == 64 && ranOffMain == 0, "post_main runs on the main thread", js.thread_count());
+}
+
+static double spawn_ns(JobSystem& js, int jobs) {
+    JobCounter c;
+    auto t0 = bench_clock::now();
+    for (int i = 0; i < jobs; i++) js.spawn([] {}, c);
+    js.wait(c);
+    return ms_since(t0) * 1e6 / jobs;
+}
+
+// main pushes one job and spins without helping; a worker has to steal it
+static double steal_us(JobSystem& js, bool cold, int reps) {
+    Samples us;
+    for (int r = 0; r < reps; r++) {
+        if (cold) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        else { JobCounter warm; js.spawn([] {}, warm); js.wait(warm); }
+        std::atomic<bool> started{ false };
+        JobCounter c;
+        auto t0 = bench_clock::now();
+        js.spawn([&] { started.store(true, std::memory_order_release); }, c);
+        while (!started.load(std::memory_order_acquire)) {}
+        us.add(ms_since(t0) * 1000.0);
+        js.wait(c);
+    }
+    return us.mean();
+}
+
+int main(int argc, char* argv[]) {
+    int jobs = (argc > 1) ? std::max(1000, std::atoi(argv[1])) : 200000;
+
+    std::printf("%u hardware threads\n\n", std::thread::hardware_concurrency());
+    std::printf("%-8s %14s %14s %14s\n", "threads", "spawn ns/job", "steal hot us", "steal cold us");
+    for (int threads : { 1, 2, 4, 8 }) {
+        JobSystem js(threads);
+        check_parallel_for(js);
+        check_task_graph(js);
+        check_spawn_and_main_queue(js);
+
+        double spawn = spawn_ns(js, jobs);
+        if (threads == 1) std::printf("%-8d %14.1f %14s %14s\n", threads, spawn, "-", "-");
+        else std::printf("%-8d %14.1f %14.2f %14.2f\n", threads, spawn, steal_us(js, false, 200), steal_us(js, true, 50));
+    }
+    std::printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+﻿#include <cstdio>
+#include <cstdlib>
+
+#include "bench_common.h"
+#include "simulation.h"
+
+// Zombie AI level of detail and time-sliced steering (ai_lod.h) on a large
+// map:
+//  1. ms per tick with everyone steering every tick vs the default tiers,
+//     the zombies per tier and how many re-steered per tick
+//  2. time slicing as the horde grows: mean and worst re-steers and ms per
+//     tick with the default steer budget
+// Checks that the tier counts add up to the horde, that with LOD and
+// slicing off everyone steers every tick, that re-steers stay within the
+// budget (plus one bucket of rounding), and that LOD on hashes the same at
+// 1 and 4 threads; any failure makes the exit code non-zero. Simulation
+// only, no SDL; run from the project directory so data/ is found.
+//
+// usage: bench_lod [ticks] [map size]
+
+struct Result {
+    Samples ms;
+    AiLodStats perTick;     // averaged over the timed ticks
+    int maxSteered{ 0 };
+    bool tiersAddUp{ true };
+    uint64_t hash{};
+};
+
+static Result run(int size, int zombies, const AiLodConfig& lod, int threads, int ticks) {
+    const float dt = 1.f / 60.f;
+    Simulation sim(size, size);
+    sim.set_worker_threads(threads);
+    sim.set_ai_lod(lod);
+    sim.load_scene(zombies, 0, 5);
+    sim.run_systems(dt); // warm-up (buffers, grids, first steer of everyone)
+
+    Result res;
+    AiLodStats sum;
+    for (int t = 0; t < ticks; t++) {
+        auto t0 = bench_clock::now();
+        sim.run_systems(dt);
+        res.ms.add(ms_since(t0));
+        const AiLodStats& s = sim.ai_lod_stats();
+        sum.add(s);
+        res.maxSteered = std::max(res.maxSteered, s.total_steered());
+        // zombies die only to bullets, and there are none
+        res.tiersAddUp &= s.total() == zombies;
+    }
+    for (int t = 0; t < AI_TIER_COUNT; t++) {
+        res.perTick.tier[t] = sum.tier[t] / ticks;
+        res.perTick.steered[t] = sum.steered[t] / ticks;
+    }
+    res.hash = sim.state_hash();
+    return res;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 60;
+    int size = (argc > 2) ? std::max(540, std::atoi(argv[2])) : 4096;
+
+    const AiLodConfig on;
+    AiLodConfig off;
+    off.enabled = false;
+    off.nearInterval = 1;
+    off.steerBudget = 0;
+
+    std::printf("%dx%d map, %d ticks per case, near < %.0f (every %d), mid < %.0f (every %d), far every %d, budget %d\n\n",
+        size, size, ticks, on.nearRadius, on.nearInterval, on.midRadius, on.midInterval, on.farInterval, on.steerBudget);
+    std::printf("%-9s %-4s %10s %8s %8s %8s %14s\n", "zombies", "lod", "ms/tick", "near", "mid", "far", "steered/tick");
+
+    int failures = 0;
+    for (int n : { 20000, 100000 }) {
+        for (bool lod : { false, true }) {
+            Result res = run(size, n, lod ? on : off, 1, ticks);
+            const AiLodStats& s = res.perTick;
+            std::printf("%-9d %-4s %10.3f %8d %8d %8d %14d\n", n, lod ? "on" : "off", res.ms.mean(),
+                s.tier[AI_NEAR], s.tier[AI_MID], s.tier[AI_FAR], s.total_steered());
+            if (!res.tiersAddUp) { std::printf("FAIL  tier counts don't add up to the horde\n"); failures++; }
+            if (!lod && (s.tier[AI_NEAR] != n || s.total_steered() != n)) { std::printf("FAIL  LOD off skipped zombies\n"); failures++; }
+            if (lod) {
+                Result par = run(size, n, on, 4, ticks);
+                if (par.hash != res.hash) { std::printf("FAIL  hash differs at 4 threads\n"); failures++; }
+            }
+        }
+    }
+
+    // everyone in the near tier, so only the budget stretches the interval
+    AiLodConfig sliced = off;
+    sliced.steerBudget = on.steerBudget;
+    std::printf("\ntime slicing, budget %d, LOD tiers off\n", sliced.steerBudget);
+    std::printf("%-9s %14s %14s %10s %10s\n", "zombies", "steered/tick", "worst", "ms/tick", "worst ms");
+    for (int n : { 10000, 25000, 50000, 100000 }) {
+        Result res = run(size, n, sliced, 1, ticks);
+        std::printf("%-9d %14d %14d %10.3f %10.3f\n", n, res.perTick.total_steered(), res.maxSteered, res.ms.mean(), res.ms.max());
+        // slots are dense here, so each bucket holds at most ceil(n / interval)
+        int interval = ai_budget_interval(n, sliced);
+        if (res.maxSteered > (n + interval - 1) / interval) { std::printf("FAIL  over the steer budget\n"); failures++; }
+    }
+
+    return failures ? 1 : 0;
+}
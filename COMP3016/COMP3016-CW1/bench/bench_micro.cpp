@@ -0,0 +1,212 @@
+﻿#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "components.h"
+#include "player.h"
+#include "text.h"
+#include "vec2.h"
+#include "wave_config.h"
+
+// Microbenchmarks of the hot helpers, ns per call:
+//   circle_hit, Vec2::normalized, steer_zombie, sprite pick (facing_sector
+//   + texture table, as in draw_zombies / Player::pick_texture),
+//   remove_dead, find_glyph, draw_text into a null renderer (software
+//   renderer over a 1x1 surface, so it's all call overhead) and
+//   load_wave_config on a file with every key.
+// Each one gets warm-up runs that also pick the iteration count (a sample
+// lasts ~5 ms), then timed samples; mean, stddev, min and max ns/op are
+// reported as a table, or as JSON with --json.
+//
+// usage: bench_micro [--json] [samples]
+
+static volatile uint64_t sink;
+
+static void keep(uint64_t v) { sink = sink + v; }
+static void keep(float v) { uint32_t u; std::memcpy(&u, &v, sizeof(u)); keep((uint64_t)u); }
+
+struct Result {
+    const char* name;
+    int warmups;
+    long long iters;        // per sample
+    Samples ns;             // ns/op per sample
+};
+
+// op(n) performs n operations
+template<typename Op>
+static Result measure(const char* name, Op op, int samples) {
+    const double sampleMs = 5.0;
+    Result r{ name, 0, 1, {} };
+    // warm-up: grow n until one run is long enough to time
+    for (;;) {
+        auto t0 = bench_clock::now();
+        op(r.iters);
+        double ms = ms_since(t0);
+        r.warmups++;
+        if (ms >= sampleMs || r.iters >= (1LL << 32)) break;
+        r.iters *= ms > 0.05 ? std::max(2LL, (long long)(sampleMs / ms) + 1) : 16;
+    }
+    op(r.iters);
+    r.warmups++;
+    for (int s = 0; s < samples; s++) {
+        auto t0 = bench_clock::now();
+        op(r.iters);
+        r.ns.add(ms_since(t0) * 1e6 / (double)r.iters);
+    }
+    return r;
+}
+
+static void print_table(const std::vector<Result>& rs) {
+    std::printf("%-20s %8s %12s %10s %9s %10s %10s\n", "function", "warm-up", "iters", "ns/op", "stddev", "min", "max");
+    for (const Result& r : rs)
+        std::printf("%-20s %8d %12lld %10.2f %9.2f %10.2f %10.2f\n", r.name, r.warmups, r.iters,
+            r.ns.mean(), r.ns.stddev(), r.ns.min(), r.ns.max());
+}
+
+static void print_json(const std::vector<Result>& rs, int samples) {
+    std::printf("{\n  \"samples\": %d,\n  \"benchmarks\": [\n", samples);
+    for (size_t i = 0; i < rs.size(); i++) {
+        const Result& r = rs[i];
+        double sd = r.ns.stddev();
+        std::printf("    { \"name\": \"%s\", \"warmup_runs\": %d, \"iterations\": %lld, "
+            "\"ns_per_op\": %.3f, \"stddev_ns\": %.3f, \"variance_ns2\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f }%s\n",
+            r.name, r.warmups, r.iters, r.ns.mean(), sd, sd * sd, r.ns.min(), r.ns.max(), i + 1 < rs.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    int samples = 20;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--json")) json = true;
+        else samples = std::max(2, std::atoi(argv[i]));
+    }
+
+    // inputs: power-of-two tables indexed by the iteration, so nothing folds
+    const int N = 1024, MASK = N - 1;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(0.f, 960.f), unit(-1.f, 1.f);
+    std::vector<Vec2> a(N), b(N), dirs(N);
+    for (int i = 0; i < N; i++) {
+        a[i] = { coord(rng), coord(rng) * 0.5625f };
+        b[i] = a[i] + Vec2{ unit(rng), unit(rng) } * 40.f;
+        dirs[i] = { unit(rng), unit(rng) };
+    }
+
+    std::vector<Result> results;
+
+    results.push_back(measure("circle_hit", [&](long long n) {
+        uint64_t hits = 0;
+        for (long long i = 0; i < n; i++) hits += circle_hit(a[i & MASK], 14.f, b[(i * 7) & MASK], 4.f);
+        keep(hits);
+    }, samples));
+
+    results.push_back(measure("Vec2::normalized", [&](long long n) {
+        float s = 0.f;
+        for (long long i = 0; i < n; i++) s += dirs[i & MASK].normalized().x;
+        keep(s);
+    }, samples));
+
+    {
+        ZombieArch zs;
+        for (int i = 0; i < N; i++) spawn_zombie_at(zs, a[i], 90.f);
+        results.push_back(measure("steer_zombie", [&](long long n) {
+            for (long long i = 0; i < n; i++) steer_zombie(zs, (int)(i & MASK), dirs[i & MASK], dirs[(i * 3) & MASK] * 0.3f);
+            keep(zs.get<Velocity>(0).vel.x);
+        }, samples));
+    }
+
+    {
+        // stand-in texture pointers, only compared and summed
+        SDL_Texture* tex[8];
+        for (int k = 0; k < 8; k++) tex[k] = reinterpret_cast<SDL_Texture*>((uintptr_t)(k + 1) * 64);
+        results.push_back(measure("pick_texture", [&](long long n) {
+            uint64_t s = 0;
+            for (long long i = 0; i < n; i++) s += (uintptr_t)tex[facing_sector(dirs[i & MASK])];
+            keep(s);
+        }, samples));
+    }
+
+    {
+        // the game's zombie setup (handles, swap-and-pop); one op kills every
+        // 8th of 4096 rows, compacts and spawns them back
+        const int ROWS = 4096;
+        ZombieArch zs;
+        zs.set_handles(true);
+        zs.set_swap_remove(true);
+        for (int i = 0; i < ROWS; i++) spawn_zombie_at(zs, a[i & MASK], 90.f);
+        results.push_back(measure("remove_dead", [&](long long n) {
+            for (long long k = 0; k < n; k++) {
+                for (int i = (int)(k & 7); i < ROWS; i += 8) zs.alive[i] = 0;
+                zs.remove_dead();
+                while (zs.size() < ROWS) spawn_zombie_at(zs, a[zs.size() & MASK], 90.f);
+            }
+            keep((uint64_t)zs.size());
+        }, samples));
+    }
+
+    {
+        const char text[] = "WAVE 12 PISTOL INF SHOTGUN 24 RIFLE 90 -";
+        const int len = (int)sizeof(text) - 1;
+        results.push_back(measure("find_glyph", [&](long long n) {
+            uint64_t s = 0;
+            for (long long i = 0; i < n; i++) s += find_glyph(text[i % len])->rows[3];
+            keep(s);
+        }, samples));
+    }
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_Surface* target = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_XRGB8888);
+        SDL_Renderer* r = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+        if (r) {
+            const std::string hud[4] = { "WAVE 12", "PISTOL INF", "SHOTGUN 24", "RIFLE 90" };
+            results.push_back(measure("draw_text", [&](long long n) {
+                for (long long i = 0; i < n; i++) {
+                    draw_text(r, 16.f, 10.f, hud[i & 3], 2.0f);
+                    // keep SDL's command queue from growing over a sample
+                    if ((i & 63) == 63) SDL_FlushRenderer(r);
+                }
+                SDL_FlushRenderer(r);
+            }, samples));
+            SDL_DestroyRenderer(r);
+        }
+        else std::fprintf(stderr, "draw_text skipped: %s\n", SDL_GetError());
+        SDL_DestroySurface(target);
+        SDL_Quit();
+    }
+    else std::fprintf(stderr, "draw_text skipped: SDL_Init: %s\n", SDL_GetError());
+
+    {
+        const char* path = "bench_micro_waves.txt";
+        {
+            std::ofstream f(path);
+            f << "# every key load_wave_config knows\n"
+                "maxZombies = 40\nzombieSpeed = 95\nspawnInterval = 0.8\n"
+                "waveCount = 8\nwaveCountStep = 5\nwaveCap = 6\nwaveCapStep = 2\nwaveCapMax = 40\n"
+                "spawnDecay = 0.92\nspawnIntervalMin = 0.2\nspeedStep = 0.06\nintermission = 3\n"
+                "separationRadius = 30\nseparationWeight = 1.5\ncohesionWeight = 0.25\ncrowdNeighbours = 10\n"
+                "aiLod = 1\naiNearRadius = 380\naiMidRadius = 760\naiNearInterval = 2\n"
+                "aiMidInterval = 4\naiFarInterval = 12\naiSteerBudget = 4096\n";
+        }
+        results.push_back(measure("load_wave_config", [&](long long n) {
+            uint64_t s = 0;
+            for (long long i = 0; i < n; i++) s += (uint64_t)load_wave_config(path).maxZombies;
+            keep(s);
+        }, samples));
+        std::remove(path);
+    }
+
+    if (json) print_json(results, samples);
+    else print_table(results);
+    return 0;
+}
@@ -0,0 +1,148 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "collision_grid.h"
+#include "vec2.h"
+
+// Map collision against the precomputed grid.
+//  1. tunnelling check: bullets at and far above the rifle's 780 px/s, at a
+//     33 ms tick, fired across one-cell-thick crates from every direction;
+//     circles shoved across the same crates in big steps. Any pass-through
+//     is reported and makes the exit code non-zero.
+//  2. per-tick cost of move_circle + segment_hit at large entity counts.
+//
+// usage: bench_obstacles [ticks]
+
+static const float CELL = 8.f;
+
+// does the segment a -> b touch the box? (slab test)
+static bool segment_box(const Vec2& a, const Vec2& b, float x0, float y0, float x1, float y1) {
+    float t0 = 0.f, t1 = 1.f;
+    Vec2 d = b - a;
+    const float lo[2] = { x0, y0 }, hi[2] = { x1, y1 }, o[2] = { a.x, a.y }, v[2] = { d.x, d.y };
+    for (int k = 0; k < 2; k++) {
+        if (v[k] == 0.f) { if (o[k] < lo[k] || o[k] > hi[k]) return false; continue; }
+        float ta = (lo[k] - o[k]) / v[k], tb = (hi[k] - o[k]) / v[k];
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta); t1 = std::min(t1, tb);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+static int tunnelling_check() {
+    const float W = 960.f, H = 540.f, dt = 0.033f;
+    CollisionGrid grid;
+    grid.reset(W, H, CELL);
+
+    // a ring of single-cell crates around the centre
+    std::vector<Obstacle> crates;
+    for (int i = 0; i < 24; i++) {
+        float a = i * (2.f * PI / 24.f);
+        float x = std::floor((480.f + std::cos(a) * 160.f) / CELL) * CELL;
+        float y = std::floor((270.f + std::sin(a) * 160.f) / CELL) * CELL;
+        crates.push_back({ Obstacle::Crate, x, y, CELL, CELL });
+        grid.add_rect(x, y, CELL, CELL);
+    }
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> jitter(-1.f, 1.f);
+    const float speeds[] = { 780.f, 1560.f, 3120.f, 6240.f };
+    int fired = 0, tunnelled = 0;
+    for (float speed : speeds) {
+        for (const Obstacle& c : crates) {
+            for (int k = 0; k < 64; k++) {
+                // aim at a random point of the crate from ~2 ticks away
+                Vec2 target{ c.x + CELL * 0.5f + jitter(rng) * 3.9f, c.y + CELL * 0.5f + jitter(rng) * 3.9f };
+                float a = k * (2.f * PI / 64.f);
+                Vec2 dir{ std::cos(a), std::sin(a) };
+                Vec2 p = target - dir * (speed * dt * (1.5f + 0.5f * jitter(rng)));
+                if (grid.blocked_at(p.x, p.y)) continue;
+                fired++;
+
+                bool hit = false, crossed = false;
+                for (int t = 0; t < 6 && !hit; t++) {
+                    Vec2 next = p + dir * (speed * dt);
+                    Vec2 at;
+                    if (grid.segment_hit(p, next, &at)) { hit = true; break; }
+                    for (const Obstacle& o : crates)
+                        crossed |= segment_box(p, next, o.x, o.y, o.x + o.w - 0.001f, o.y + o.h - 0.001f);
+                    p = next;
+                }
+                if (crossed && !hit) tunnelled++;
+            }
+        }
+    }
+
+    // circles pushed across a crate in one large step must stop in front
+    int pushed = 0, passed = 0;
+    for (const Obstacle& c : crates) {
+        for (int k = 0; k < 4; k++) {
+            Vec2 dir = (k == 0) ? Vec2{ 1,0 } : (k == 1) ? Vec2{ -1,0 } : (k == 2) ? Vec2{ 0,1 } : Vec2{ 0,-1 };
+            Vec2 centre{ c.x + CELL * 0.5f, c.y + CELL * 0.5f };
+            Vec2 p = centre - dir * 30.f;
+            if (grid.overlaps(p, 14.f)) continue;
+            pushed++;
+            Vec2 q = grid.move_circle(p, dir * 60.f, 14.f);
+            float before = (centre - p).x * dir.x + (centre - p).y * dir.y;
+            float after = (centre - q).x * dir.x + (centre - q).y * dir.y;
+            if (before > 0.f && after <= 0.f) passed++;
+            if (grid.overlaps(q, 14.f)) passed++;
+        }
+    }
+
+    std::printf("tunnelling: %d bullets at 780-6240 px/s, %d passed through\n", fired, tunnelled);
+    std::printf("            %d circle sweeps, %d ended past or inside a crate\n\n", pushed, passed);
+    return tunnelled + passed;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 30;
+    int failures = tunnelling_check();
+
+    const int counts[] = { 1000, 10000, 100000 };
+    const float dt = 1.f / 60.f;
+    std::printf("%d ticks per case, half zombies / half bullets\n\n", ticks);
+    std::printf("%-9s %12s %10s %12s\n", "entities", "world", "ms/tick", "ns/entity");
+
+    for (int n : counts) {
+        float s = std::max(1.f, std::sqrt(n / 1000.f));
+        float W = 960.f * s, H = 540.f * s;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> dx(20.f, W - 20.f), dy(20.f, H - 20.f), ang(0.f, 2.f * PI);
+
+        CollisionGrid grid;
+        grid.reset(W, H, CELL);
+        int obstacleCount = int(10 * s * s);
+        for (int i = 0; i < obstacleCount; i++) {
+            bool wall = (i % 3) == 0;
+            grid.add_rect(dx(rng), dy(rng), wall ? 16.f : 32.f, wall ? 120.f : 32.f);
+        }
+
+        std::vector<Vec2> zp(n / 2), zv(n / 2), bp(n - n / 2), bv(n - n / 2);
+        for (size_t i = 0; i < zp.size(); i++) { float a = ang(rng); zp[i] = { dx(rng), dy(rng) }; zv[i] = Vec2{ std::cos(a), std::sin(a) } * 120.f; }
+        for (size_t i = 0; i < bp.size(); i++) { float a = ang(rng); bp[i] = { dx(rng), dy(rng) }; bv[i] = Vec2{ std::cos(a), std::sin(a) } * 780.f; }
+
+        int hits = 0;
+        auto t0 = bench_clock::now();
+        for (int t = 0; t < ticks; t++) {
+            for (size_t i = 0; i < zp.size(); i++) {
+                zp[i] = grid.move_circle(zp[i], zv[i] * dt, 14.f);
+                zp[i].x = std::clamp(zp[i].x, 20.f, W - 20.f);
+                zp[i].y = std::clamp(zp[i].y, 20.f, H - 20.f);
+            }
+            for (size_t i = 0; i < bp.size(); i++) {
+                Vec2 next = bp[i] + bv[i] * dt;
+                if (grid.segment_hit(bp[i], next)) { hits++; bv[i] = bv[i] * -1.f; }
+                else bp[i] = next;
+                if (bp[i].x < 0 || bp[i].y < 0 || bp[i].x > W || bp[i].y > H) bv[i] = bv[i] * -1.f;
+            }
+        }
+        double ms = ms_since(t0) / ticks;
+        std::printf("%-9d %6.0fx%-5.0f %10.3f %12.1f   (%d bullet hits)\n", n, W, H, ms, ms * 1e6 / n, hits);
+    }
+    return failures ? 1 : 0;
+}
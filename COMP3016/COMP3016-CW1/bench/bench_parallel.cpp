@@ -0,0 +1,47 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "bench_common.h"
+#include "simulation.h"
+
+// Game systems on the worker pool: ms per tick at 1, 2, 4 and 8 threads for
+// 10k, 50k and 100k zombies (plus a tenth as many bullets), and a check that
+// the state after the run hashes the same at every thread count (exit code 1
+// otherwise). Simulation only, no SDL; run from the project directory so
+// data/ is found.
+//
+// usage: bench_parallel [ticks]
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 60;
+    const int width = 960, height = 540;
+    const float dt = 1.f / 60.f;
+
+    std::printf("%d ticks per case, %u hardware threads\n\n", ticks, std::thread::hardware_concurrency());
+    std::printf("%-9s %-8s %10s %9s %18s\n", "zombies", "threads", "ms/tick", "speedup", "state hash");
+
+    int failures = 0;
+    for (int n : { 10000, 50000, 100000 }) {
+        double base = 0.0;
+        uint64_t serialHash = 0;
+        for (int threads : { 1, 2, 4, 8 }) {
+            // a fresh game per case, load_scene() leaves the player state alone
+            Simulation sim(width, height);
+            sim.set_worker_threads(threads);
+            sim.load_scene(n, n / 10, 5);
+            sim.run_systems(dt); // warm-up (buffers, grids)
+            auto t0 = bench_clock::now();
+            for (int t = 0; t < ticks; t++) sim.run_systems(dt);
+            double ms = ms_since(t0) / ticks;
+            uint64_t h = sim.state_hash();
+            if (threads == 1) { base = ms; serialHash = h; }
+            bool same = h == serialHash;
+            if (!same) failures++;
+            std::printf("%-9d %-8d %10.3f %8.2fx   %016llx%s\n", n, threads, ms, base / ms,
+                (unsigned long long)h, same ? "" : "  MISMATCH");
+        }
+    }
+
+    return failures ? 1 : 0;
+}
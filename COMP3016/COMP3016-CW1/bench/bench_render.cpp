@@ -0,0 +1,83 @@
+﻿#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+#include "bench_common.h"
+#include "game.h"
+
+// Render benchmark: SDL's software renderer drawing into an offscreen surface
+// with the dummy video driver, so numbers don't depend on a GPU or a window.
+// Run from the project directory so data/ is found (otherwise every sprite
+// falls back to a filled rect).
+//
+// usage: bench_render [frames]
+
+struct Scene { const char* name; int zombies; int bullets; };
+
+static const Scene SCENES[] = {
+    { "empty",        0,    0 },
+    { "wave1",        8,    4 },
+    { "cap40",       40,   30 },
+    { "horde500",   500,  200 },
+    { "horde2000", 2000, 1000 },
+};
+
+struct Result { double msMean, msStd, msMax; double drawCalls, texSwitches; };
+
+static Result run(int frames, const std::function<void()>& frame) {
+    for (int i = 0; i < 10; i++) frame(); // warm-up
+
+    Samples ms;
+    RenderStats total{};
+    for (int i = 0; i < frames; i++) {
+        render_stats().reset();
+        auto t0 = bench_clock::now();
+        frame();
+        ms.add(ms_since(t0));
+        total.drawCalls += render_stats().drawCalls;
+        total.textureSwitches += render_stats().textureSwitches;
+    }
+    return { ms.mean(), ms.stddev(), ms.max(),
+        (double)total.drawCalls / frames, (double)total.textureSwitches / frames };
+}
+
+static void report(const std::string& name, const Result& r) {
+    std::printf("%-22s %9.3f %8.3f %9.3f %11.0f %11.0f\n",
+        name.c_str(), r.msMean, r.msStd, r.msMax, r.drawCalls, r.texSwitches);
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 200;
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_VIDEO)) { std::fprintf(stderr, "SDL_Init: %s\n", SDL_GetError()); return 1; }
+
+    const int width = 960, height = 540;
+    SDL_Surface* target = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer* r = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!r) { std::fprintf(stderr, "software renderer: %s\n", SDL_GetError()); SDL_Quit(); return 1; }
+
+    std::printf("%d frames per case, %dx%d software renderer\n\n", frames, width, height);
+    std::printf("%-22s %9s %8s %9s %11s %11s\n", "case", "ms/frame", "stddev", "max", "draws", "tex-switch");
+
+    {
+        Game game(r, nullptr, width, height);
+        for (const Scene& s : SCENES) {
+            game.sim().load_scene(s.zombies, s.bullets);
+            report(std::string("draw/") + s.name, run(frames, [&] { game.draw(); }));
+        }
+        report("draw_hud", run(frames, [&] { game.draw_hud(); }));
+    }
+
+    report("draw_text/short", run(frames, [&] { draw_text(r, 16.f, 10.f, "WAVE 12"); }));
+    report("draw_text/long", run(frames, [&] { draw_text(r, 16.f, 10.f, "SG 24 - RF 90 - PST INF - WAVE 12 - 0123456789"); }));
+
+    SDL_DestroyRenderer(r);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,92 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "zombie_kernels.h"
+
+// Fused zombie kernel: every SIMD level the CPU has, precise and fast.
+// Precise results must be bit-identical to the scalar loop (exit code 1 if
+// not); fast results report their largest velocity error.
+//
+// usage: bench_simd [reps]
+
+struct State {
+    std::vector<Vec2> pos, vel, face;
+    std::vector<float> speed, dx, dy;
+
+    explicit State(int n, unsigned seed) : pos(n), vel(n), face(n, Vec2{ 1,0 }), speed(n), dx(n), dy(n) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> px(0.f, 1000.f), d(-2.f, 2.f), s(60.f, 140.f);
+        for (int i = 0; i < n; i++) {
+            pos[i].x = px(rng); pos[i].y = px(rng) * 0.6f; speed[i] = s(rng);
+            dx[i] = d(rng); dy[i] = d(rng);
+            if (i % 17 == 0) { dx[i] = 0.f; dy[i] = 0.f; }          // standing still
+            if (i % 29 == 0) { dx[i] = 0.00005f; dy[i] = 0.f; }     // below the threshold
+        }
+    }
+
+    ZombieKernelArgs args() {
+        ZombieKernelArgs a;
+        a.pos = pos.data(); a.vel = vel.data();
+        a.speed = speed.data(); a.dirX = dx.data(); a.dirY = dy.data(); a.face = face.data();
+        a.n = (int)pos.size();
+        a.integrate = true; a.dt = 1.f / 60.f;
+        a.minX = 20.f; a.minY = 20.f; a.maxX = 940.f; a.maxY = 520.f;
+        return a;
+    }
+};
+
+static bool same_bits(const std::vector<Vec2>& a, const std::vector<Vec2>& b) {
+    return std::memcmp(a.data(), b.data(), a.size() * sizeof(Vec2)) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int reps = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 200;
+    SimdLevel best = detect_simd();
+    std::printf("detected: %s, %d reps\n\n", simd_level_name(best), reps);
+
+    std::vector<SimdLevel> levels{ SimdLevel::Scalar };
+    if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+    if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+    int failures = 0;
+    const int sizes[] = { 1003, 100003 };   // odd sizes so the scalar tail runs
+    std::printf("%-8s %-7s %-8s %10s %12s\n", "n", "level", "mode", "ns/zombie", "vs scalar");
+    for (int n : sizes) {
+        State ref(n, 11);
+        zombie_kernel(ref.args(), SimdLevel::Scalar, true);
+
+        for (SimdLevel level : levels) {
+            for (bool precise : { true, false }) {
+                State st(n, 11);
+                zombie_kernel(st.args(), level, precise);
+
+                char check[32];
+                if (precise) {
+                    bool same = same_bits(ref.pos, st.pos) && same_bits(ref.vel, st.vel) && same_bits(ref.face, st.face);
+                    if (!same) failures++;
+                    std::snprintf(check, sizeof(check), "%s", same ? "identical" : "DIFFERENT");
+                }
+                else {
+                    float err = 0.f;
+                    for (int i = 0; i < n; i++) err = std::max(err, std::max(std::abs(ref.vel[i].x - st.vel[i].x), std::abs(ref.vel[i].y - st.vel[i].y)));
+                    std::snprintf(check, sizeof(check), "max %.2e", err);
+                }
+
+                // timing: integrate=false so the state doesn't drift between reps
+                State tm(n, 11);
+                ZombieKernelArgs a = tm.args();
+                a.integrate = false;
+                auto t0 = bench_clock::now();
+                for (int r = 0; r < reps; r++) zombie_kernel(a, level, precise);
+                double ns = ms_since(t0) * 1e6 / ((double)reps * n);
+
+                std::printf("%-8d %-7s %-8s %10.3f %12s\n", n, simd_level_name(level), precise ? "precise" : "fast", ns, check);
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
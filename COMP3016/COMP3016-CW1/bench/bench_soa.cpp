@@ -0,0 +1,156 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "components.h"
+#include "spatial_grid.h"
+#include "vec2.h"
+
+// Zombie/bullet tick cost, array-of-objects vs ECS archetype columns.
+// "aos" mirrors the old layout: Entity base with a vtable, eight sprite
+// pointers, spriteScale and faceDir next to pos/vel in every zombie, updated
+// through virtual calls. "soa" is ZombieArch/BulletArch as Game uses them.
+// Both run the same tick: seek + integrate + clamp, bullet ageing, grid
+// broadphase kills, and dead removal.
+//
+// usage: bench_soa [ticks]
+
+namespace aos {
+struct Entity {
+    Vec2 pos, vel;
+    float radius{ 12.f };
+    bool alive{ true };
+    virtual ~Entity() = default;
+    virtual void update(float dt) { pos += vel * dt; }
+};
+struct Bullet : Entity {
+    float lifetime{ 1.2f }, age{ 0.f };
+    Bullet(const Vec2& p, const Vec2& v) { pos = p; vel = v; radius = 4.f; }
+    void update(float dt) override { age += dt; if (age >= lifetime) alive = false; Entity::update(dt); }
+};
+struct Zombie : Entity {
+    float speed{ 80.f };
+    void* tex[8]{};
+    float spriteScale{ 0.06f };
+    Vec2 faceDir{ 1,0 };
+    Zombie(const Vec2& p, float s) { pos = p; speed = s; radius = 14.f; }
+    void steer_to(const Vec2& t) { Vec2 d = (t - pos).normalized(); vel = d * speed; if (d.len() > 0.0001f) faceDir = d; }
+    void update(float dt) override { pos += vel * dt; }
+};
+}
+
+struct Arena { float W, H; Vec2 target; };
+
+static int tick_aos(std::vector<aos::Zombie>& zs, std::vector<aos::Bullet>& bs, SpatialGrid& grid, const Arena& w, float dt) {
+    for (auto& z : zs) {
+        z.steer_to(w.target);
+        z.update(dt);
+        z.pos.x = std::clamp(z.pos.x, 20.f, w.W - 20.f);
+        z.pos.y = std::clamp(z.pos.y, 20.f, w.H - 20.f);
+    }
+    for (auto& b : bs) b.update(dt);
+    grid.build((int)bs.size(), [&](int i) { return bs[i].pos; });
+    int kills = 0;
+    for (auto& z : zs) {
+        int hit = -1;
+        grid.query_radius(z.pos, z.radius + 4.f, [&](int i) {
+            if (bs[i].alive && (hit < 0 || i < hit) && circle_hit(z.pos, z.radius, bs[i].pos, bs[i].radius)) hit = i;
+        });
+        if (hit >= 0) { z.alive = false; bs[hit].alive = false; kills++; }
+    }
+    bs.erase(std::remove_if(bs.begin(), bs.end(), [](const aos::Bullet& b) { return !b.alive; }), bs.end());
+    zs.erase(std::remove_if(zs.begin(), zs.end(), [](const aos::Zombie& z) { return !z.alive; }), zs.end());
+    return kills;
+}
+
+static int tick_soa(ZombieArch& zs, BulletArch& bs, SpatialGrid& grid, const Arena& w, float dt) {
+    const int nz = zs.size();
+    Transform* ztf = zs.data<Transform>();
+    Velocity* zvel = zs.data<Velocity>();
+    Sprite* zsp = zs.data<Sprite>();
+    const AI* ai = zs.data<AI>();
+    const Collider* zcol = zs.data<Collider>();
+    for (int i = 0; i < nz; i++) {
+        Vec2 d = (w.target - ztf[i].pos).normalized();
+        zvel[i].vel = d * ai[i].speed;
+        if (d.len() > 0.0001f) zsp[i].faceDir = d;
+    }
+    for (int i = 0; i < nz; i++) {
+        Vec2& p = ztf[i].pos;
+        p.x = std::clamp(p.x + zvel[i].vel.x * dt, 20.f, w.W - 20.f);
+        p.y = std::clamp(p.y + zvel[i].vel.y * dt, 20.f, w.H - 20.f);
+    }
+    Transform* btf = bs.data<Transform>();
+    const Velocity* bvel = bs.data<Velocity>();
+    Lifetime* life = bs.data<Lifetime>();
+    const Collider* bcol = bs.data<Collider>();
+    for (int i = 0; i < bs.size(); i++) {
+        life[i].age += dt;
+        if (life[i].age >= life[i].life) bs.alive[i] = 0;
+        btf[i].pos += bvel[i].vel * dt;
+    }
+    grid.build(bs.size(), [&](int i) { return btf[i].pos; });
+    int kills = 0;
+    for (int zi = 0; zi < nz; zi++) {
+        Vec2 zp = ztf[zi].pos;
+        float zr = zcol[zi].radius;
+        int hit = -1;
+        grid.query_radius(zp, zr + 4.f, [&](int i) {
+            if (bs.alive[i] && (hit < 0 || i < hit) && circle_hit(zp, zr, btf[i].pos, bcol[i].radius)) hit = i;
+        });
+        if (hit >= 0) { zs.alive[zi] = 0; bs.alive[hit] = 0; kills++; }
+    }
+    bs.remove_dead();
+    zs.remove_dead();
+    return kills;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 60;
+    const float dt = 1.f / 60.f;
+    const int counts[] = { 1000, 10000, 100000 };
+
+    std::printf("%d ticks per case, bullets = zombies / 10, respawned every tick\n", ticks);
+    std::printf("sizeof: aos::Zombie %zu B, ECS zombie row %zu B\n\n", sizeof(aos::Zombie),
+        sizeof(Transform) + sizeof(Velocity) + sizeof(Collider) + sizeof(Sprite) + sizeof(Health) + sizeof(AI) + 1);
+    std::printf("%-8s %12s %12s %9s %8s\n", "zombies", "aos ms/tick", "soa ms/tick", "speedup", "kills");
+
+    for (int n : counts) {
+        float s = std::max(1.f, std::sqrt(n / 1000.f));
+        Arena w{ 960.f * s, 540.f * s, { 480.f * s, 270.f * s } };
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> dx(20.f, w.W - 20.f), dy(20.f, w.H - 20.f), ang(0.f, 2.f * PI);
+        std::vector<Vec2> zpos(n), bpos(n / 10), bvel(n / 10);
+        for (auto& p : zpos) p = { dx(rng), dy(rng) };
+        for (size_t i = 0; i < bpos.size(); i++) { float a = ang(rng); bpos[i] = { dx(rng), dy(rng) }; bvel[i] = Vec2{ std::cos(a), std::sin(a) } * 620.f; }
+
+        SpatialGrid grid;
+        grid.reset(w.W, w.H, 28.f);
+
+        std::vector<aos::Zombie> az; std::vector<aos::Bullet> ab;
+        ZombieArch sz; BulletArch sb;
+        az.reserve(n); ab.reserve(bpos.size()); sz.reserve(n); sb.reserve((int)bpos.size());
+        for (auto& p : zpos) { az.emplace_back(p, 90.f); spawn_zombie_at(sz, p, 90.f); }
+
+        double aosMs = 0, soaMs = 0;
+        int aosKills = 0, soaKills = 0;
+        for (int t = 0; t < ticks; t++) {
+            // top the bullets back up so every tick does the same work
+            ab.clear(); sb.clear();
+            for (size_t i = 0; i < bpos.size(); i++) { ab.emplace_back(bpos[i], bvel[i]); spawn_bullet(sb, bpos[i], bvel[i]); }
+
+            auto t0 = bench_clock::now();
+            aosKills += tick_aos(az, ab, grid, w, dt);
+            aosMs += ms_since(t0);
+            t0 = bench_clock::now();
+            soaKills += tick_soa(sz, sb, grid, w, dt);
+            soaMs += ms_since(t0);
+        }
+        std::printf("%-8d %12.3f %12.3f %8.2fx %8s\n", n, aosMs / ticks, soaMs / ticks,
+            soaMs > 0 ? aosMs / soaMs : 0.0, aosKills == soaKills ? "same" : "DIFF");
+    }
+    return 0;
+}
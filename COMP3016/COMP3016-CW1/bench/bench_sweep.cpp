@@ -0,0 +1,117 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "vec2.h"
+
+// Bullet vs zombie hit tests, discrete (circle_hit at the end of each tick)
+// vs swept (swept_circle_hit along the tick's segments).
+//  1. tunnelling check: bullets aimed through a walking zombie at the rifle's
+//     780 px/s and above, at 16-100 ms ticks. Every shot passes through the
+//     zombie, so every miss is a tunnel. The swept test must hit all of them
+//     and report a time of impact within one sub-step of a finely
+//     sub-stepped reference (exit code 1 otherwise).
+//  2. cost per pair test.
+//
+// usage: bench_sweep [shots]
+
+static const float ZOMBIE_R = 14.f, BULLET_R = 4.f;
+
+struct Shot { Vec2 b0, bv, z0, zv; };
+
+// bullet starts 3-4 ticks out and is aimed at the zombie's path, off-centre
+// by up to most of the combined radius
+static Shot make_shot(std::mt19937& rng, float speed, float dt) {
+    std::uniform_real_distribution<float> ang(0.f, 2.f * PI), off(-0.9f, 0.9f), frac(0.f, 1.f);
+    Shot s;
+    s.z0 = Vec2{ 480.f, 270.f };
+    float za = ang(rng);
+    s.zv = Vec2{ std::cos(za), std::sin(za) } * 90.f;
+    float when = (3.f + frac(rng)) * dt;      // usually between two ticks
+    Vec2 aimAt = s.z0 + s.zv * when;
+    float a = ang(rng);
+    Vec2 dir{ std::cos(a), std::sin(a) };
+    Vec2 side{ -dir.y, dir.x };
+    aimAt += side * (off(rng) * (ZOMBIE_R + BULLET_R));
+    s.b0 = aimAt - dir * (speed * when);
+    s.bv = dir * speed;
+    return s;
+}
+
+// first tick index + fraction the circles touch, or -1; `sub` steps per tick
+static float reference_toi(const Shot& s, float dt, int ticks, int sub) {
+    for (int k = 0; k <= ticks * sub; k++) {
+        float t = dt * k / sub;
+        if (circle_hit(s.b0 + s.bv * t, BULLET_R, s.z0 + s.zv * t, ZOMBIE_R)) return (float)k / sub;
+    }
+    return -1.f;
+}
+
+static int tunnelling_check(int shots) {
+    const float speeds[] = { 780.f, 1560.f, 3120.f };
+    const float dts[] = { 1.f / 60.f, 0.033f, 0.1f };
+    const int TICKS = 7, SUB = 256;
+    std::mt19937 rng(38);
+    int failures = 0;
+
+    std::printf("%-8s %-7s %8s %10s %10s\n", "speed", "dt", "shots", "discrete", "swept");
+    for (float speed : speeds) {
+        for (float dt : dts) {
+            int discrete = 0, swept = 0, badToi = 0;
+            for (int n = 0; n < shots; n++) {
+                Shot s = make_shot(rng, speed, dt);
+                bool dHit = false, sHit = false;
+                float toi = -1.f;
+                for (int t = 0; t < TICKS; t++) {
+                    Vec2 b0 = s.b0 + s.bv * (dt * t), b1 = s.b0 + s.bv * (dt * (t + 1));
+                    Vec2 z0 = s.z0 + s.zv * (dt * t), z1 = s.z0 + s.zv * (dt * (t + 1));
+                    if (!dHit && circle_hit(b1, BULLET_R, z1, ZOMBIE_R)) dHit = true;
+                    float f;
+                    if (!sHit && swept_circle_hit(z0, z1, ZOMBIE_R, b0, b1, BULLET_R, &f)) { sHit = true; toi = t + f; }
+                }
+                discrete += dHit;
+                swept += sHit;
+                float ref = reference_toi(s, dt, TICKS, SUB);
+                if (sHit && ref >= 0.f && (toi > ref + 1e-3f || toi < ref - 1.f / SUB - 1e-3f)) badToi++;
+            }
+            if (swept != shots || badToi) failures++;
+            std::printf("%-8.0f %-7.3f %8d %9.1f%% %9.1f%%%s\n", speed, dt, shots,
+                100.0 * discrete / shots, 100.0 * swept / shots, badToi ? "  BAD TOI" : "");
+        }
+    }
+    std::printf("\n");
+    return failures;
+}
+
+static void pair_cost() {
+    const int N = 1 << 16, REPS = 64;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> p(0.f, 64.f), v(-26.f, 26.f);
+    std::vector<Vec2> a0(N), a1(N), b0(N), b1(N);
+    for (int i = 0; i < N; i++) {
+        a0[i] = { p(rng), p(rng) }; a1[i] = a0[i] + Vec2{ v(rng) * 0.1f, v(rng) * 0.1f };
+        b0[i] = { p(rng), p(rng) }; b1[i] = b0[i] + Vec2{ v(rng), v(rng) };
+    }
+
+    int hits = 0;
+    auto t0 = bench_clock::now();
+    for (int r = 0; r < REPS; r++)
+        for (int i = 0; i < N; i++) hits += circle_hit(a1[i], ZOMBIE_R, b1[i], BULLET_R);
+    double discrete = ms_since(t0) * 1e6 / ((double)N * REPS);
+
+    t0 = bench_clock::now();
+    for (int r = 0; r < REPS; r++)
+        for (int i = 0; i < N; i++) { float f; hits += swept_circle_hit(a0[i], a1[i], ZOMBIE_R, b0[i], b1[i], BULLET_R, &f); }
+    double swept = ms_since(t0) * 1e6 / ((double)N * REPS);
+
+    std::printf("ns/pair: discrete %.2f, swept %.2f   (%d hits)\n", discrete, swept, hits);
+}
+
+int main(int argc, char* argv[]) {
+    int shots = (argc > 1) ? std::max(16, std::atoi(argv[1])) : 2000;
+    int failures = tunnelling_check(shots);
+    pair_cost();
+    return failures ? 1 : 0;
+}